@@ -0,0 +1,41 @@
+// SPDX-License-Identifier: MIT
+pragma solidity ^0.8.26;
+
+/// @title Multicall3
+/// @notice Subset of Multicall3 (https://github.com/mds1/multicall) used by the
+/// C++ tests to aggregate many view calls into a single `eth_call`. The local
+/// test deployment places this contract at the canonical Multicall3 address so
+/// that the same address works on the local devnet and on public networks.
+contract Multicall3 {
+    struct Call3 {
+        address target;
+        bool allowFailure;
+        bytes callData;
+    }
+
+    struct Result {
+        bool success;
+        bytes returnData;
+    }
+
+    /// @notice Execute each call in order, reverting if a call that does not
+    /// allow failure reverts.
+    /// @param calls The calls to execute.
+    /// @return returnData The success flag and return data of each call.
+    function aggregate3(Call3[] calldata calls) public payable returns (Result[] memory returnData) {
+        uint256 length = calls.length;
+        returnData = new Result[](length);
+        for (uint256 i = 0; i < length; ) {
+            Call3 calldata call = calls[i];
+            Result memory result = returnData[i];
+            (result.success, result.returnData) = call.target.call(call.callData);
+            require(call.allowFailure || result.success, "Multicall3: call failed");
+            unchecked { i += 1; }
+        }
+    }
+
+    /// @return blockNumber The block number the calls are executed against.
+    function getBlockNumber() public view returns (uint256 blockNumber) {
+        blockNumber = block.number;
+    }
+}
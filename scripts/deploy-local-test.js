@@ -18,6 +18,20 @@ async function main() {
     };
 
     await deployTestnetContracts(tokenName, tokenSymbol, args, false);
+
+    // NOTE: Install Multicall3 at its canonical address (the address it has on
+    // public networks) for the C++ tests. The code is set directly so no
+    // transaction is sent and the deterministic addresses of the contracts
+    // deployed above are unaffected.
+    const MULTICALL3_ADDRESS = "0xcA11bde05977b3631167028862bE2a173976CA11";
+    const multicall3 = await hre.artifacts.readArtifact("Multicall3");
+    await hre.network.provider.send("hardhat_setCode", [MULTICALL3_ADDRESS, multicall3.deployedBytecode]);
+    console.log(
+        '  ',
+        chalk.cyan(`Multicall3 Contract`),
+        'deployed to:',
+        chalk.greenBright(MULTICALL3_ADDRESS),
+    )
 }
 
 main().catch((error) => {
@@ -0,0 +1,114 @@
+#include <string>
+#include <vector>
+
+#include "service_node_rewards/abi.hpp"
+#include "service_node_rewards/erc20_contract.hpp"
+#include "service_node_rewards/service_node_list.hpp"
+#include "service_node_rewards/service_node_rewards_contract.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// NOTE: Synthetic response of `serviceNodes(3)` in the ABI layout the
+// contract returns, for a node with the maximum of 10 contributors. The
+// pubkey is the G1 generator, the ed25519 key and contributor addresses are
+// placeholder patterns and the 10 contributions of 1.2e10 sum to the 1.2e11
+// deposit. Only the layout matters for the decoder's cost.
+static const std::string SERVICE_NODE_RESPONSE = "0x"
+        "0000000000000000000000000000000000000000000000000000000000000020"
+        "0000000000000000000000000000000000000000000000000000000000000003"
+        "0000000000000000000000000000000000000000000000000000000000000001"
+        "00000000000000000000000070997970c51812dc3a010c7d01b50e0d17dc79c8"
+        "0000000000000000000000000000000000000000000000000000000000000001"
+        "0000000000000000000000000000000000000000000000000000000000000002"
+        "0000000000000000000000000000000000000000000000000000000066669980"
+        "0000000000000000000000000000000000000000000000000000000000000000"
+        "0000000000000000000000000000000000000000000000000000000000000000"
+        "0000000000000000000000000000000000000000000000000000001bf08eb000"
+        "0000000000000000000000000000000000000000000000000000000000000160"
+        "d3c208c16d87cfd3d3c208c16d87cfd3d3c208c16d87cfd3d3c208c16d87cfd3"
+        "000000000000000000000000000000000000000000000000000000000000000a"
+        "0000000000000000000000000000000000000000000000000000000000001000"
+        "0000000000000000000000000000000000000000000000000000000000002000"
+        "00000000000000000000000000000000000000000000000000000002cb417800"
+        "0000000000000000000000000000000000000000000000000000000000001001"
+        "0000000000000000000000000000000000000000000000000000000000002001"
+        "00000000000000000000000000000000000000000000000000000002cb417800"
+        "0000000000000000000000000000000000000000000000000000000000001002"
+        "0000000000000000000000000000000000000000000000000000000000002002"
+        "00000000000000000000000000000000000000000000000000000002cb417800"
+        "0000000000000000000000000000000000000000000000000000000000001003"
+        "0000000000000000000000000000000000000000000000000000000000002003"
+        "00000000000000000000000000000000000000000000000000000002cb417800"
+        "0000000000000000000000000000000000000000000000000000000000001004"
+        "0000000000000000000000000000000000000000000000000000000000002004"
+        "00000000000000000000000000000000000000000000000000000002cb417800"
+        "0000000000000000000000000000000000000000000000000000000000001005"
+        "0000000000000000000000000000000000000000000000000000000000002005"
+        "00000000000000000000000000000000000000000000000000000002cb417800"
+        "0000000000000000000000000000000000000000000000000000000000001006"
+        "0000000000000000000000000000000000000000000000000000000000002006"
+        "00000000000000000000000000000000000000000000000000000002cb417800"
+        "0000000000000000000000000000000000000000000000000000000000001007"
+        "0000000000000000000000000000000000000000000000000000000000002007"
+        "00000000000000000000000000000000000000000000000000000002cb417800"
+        "0000000000000000000000000000000000000000000000000000000000001008"
+        "0000000000000000000000000000000000000000000000000000000000002008"
+        "00000000000000000000000000000000000000000000000000000002cb417800"
+        "0000000000000000000000000000000000000000000000000000000000001009"
+        "0000000000000000000000000000000000000000000000000000000000002009"
+        "00000000000000000000000000000000000000000000000000000002cb417800";
+
+static const std::string CONTRACT_ADDRESS = "0x5FC8d32690cc91D4c39d9d3abcBD16989F875707";
+static const std::string SENDER_ADDRESS   = "0x70997970C51812dc3A010C7d01b50e0d17dc79C8";
+static const uint32_t    CHAIN_ID         = 31337;
+
+TEST_CASE("Decode contract responses", "[benchmark][abi]") {
+    BENCHMARK("decodeServiceNode (10 contributors)") {
+        return ServiceNodeRewardsContract::decodeServiceNode(SERVICE_NODE_RESPONSE);
+    };
+
+    BENCHMARK("decodeServiceNode (links only)") {
+        return ServiceNodeRewardsContract::decodeServiceNode(SERVICE_NODE_RESPONSE, /*linksOnly*/ true);
+    };
+}
+
+TEST_CASE("Build contract transactions", "[benchmark][abi]") {
+    ServiceNodeList            snl(100, /*signingThreads*/ 1);
+    ServiceNodeRewardsContract rewards;
+    ERC20Contract              erc20;
+    rewards.contractAddress = CONTRACT_ADDRESS;
+    erc20.contractAddress   = CONTRACT_ADDRESS;
+
+    ServiceNode&      node              = snl.nodes[0];
+    const std::string pubkey            = node.getPublicKeyHex();
+    const std::string proofOfPossession = node.proofOfPossession(CHAIN_ID, CONTRACT_ADDRESS, SENDER_ADDRESS, "pubkey");
+    const std::string signature         = snl.updateRewardsBalance(SENDER_ADDRESS, 1000, CHAIN_ID, CONTRACT_ADDRESS, snl.randomSigners(90));
+
+    std::vector<uint64_t> nonSigners;
+    for (uint64_t id = 1; id <= 10; id++)
+        nonSigners.push_back(id);
+
+    BENCHMARK("addBLSPublicKey") {
+        return rewards.addBLSPublicKey(pubkey, proofOfPossession, "pubkey", "sig", 0);
+    };
+
+    BENCHMARK("updateRewardsBalance (10 non-signers)") {
+        return rewards.updateRewardsBalance(SENDER_ADDRESS, 1000, signature, nonSigners);
+    };
+
+    BENCHMARK("liquidateBLSPublicKeyWithSignature (10 non-signers)") {
+        return rewards.liquidateBLSPublicKeyWithSignature(pubkey, 1718000000, signature, nonSigners);
+    };
+
+    BENCHMARK("ERC20 approve") {
+        return erc20.approve(SENDER_ADDRESS, 1000);
+    };
+
+    std::vector<uint64_t> values(1000, 7);
+    BENCHMARK("AbiEncoder uint64[] (1000 elements)") {
+        AbiEncoder abi{ServiceNodeRewardsContract::UPDATE_REWARDS_BALANCE, AbiEncoder::uintArrayWords(values.size())};
+        abi.uintArray(values);
+        return std::move(abi).str();
+    };
+}
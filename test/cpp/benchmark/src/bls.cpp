@@ -0,0 +1,167 @@
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "service_node_rewards/ec_utils.hpp"
+#include "service_node_rewards/service_node_list.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+static const std::string CONTRACT_ADDRESS = "0x5FC8d32690cc91D4c39d9d3abcBD16989F875707";
+static const uint32_t    CHAIN_ID         = 31337;
+
+static std::span<const uint8_t> asBytes(std::string_view value) {
+    return {reinterpret_cast<const uint8_t*>(value.data()), value.size()};
+}
+
+TEST_CASE("Hash to curve", "[benchmark][bls]") {
+    ServiceNodeList  snl(1, /*signingThreads*/ 1); // NOTE: Initialises the curve
+    const DomainTags tags{CHAIN_ID, CONTRACT_ADDRESS};
+
+    // NOTE: The largest signed message, a proof of possession
+    const std::array<uint8_t, MessageBuilder::CAPACITY> message = {};
+
+    BENCHMARK("ExpandMessageXMDKeccak256 (128 bytes)") {
+        std::array<uint8_t, 128> out;
+        utils::ExpandMessageXMDKeccak256(out, message, tags.hashToG2);
+        return out;
+    };
+
+    BENCHMARK("MapToG2") {
+        return utils::MapToG2(message, tags.hashToG2);
+    };
+
+    BENCHMARK("HashToG2") {
+        return utils::HashToG2(message, tags.hashToG2);
+    };
+
+    BENCHMARK("PreparedMessage::prepare") {
+        return PreparedMessage::prepare(message, tags);
+    };
+}
+
+TEST_CASE("Sign", "[benchmark][bls]") {
+    ServiceNodeList        snl(1, /*signingThreads*/ 1);
+    const DomainTags       tags{CHAIN_ID, CONTRACT_ADDRESS};
+    const ServiceNode&     node     = snl.nodes[0];
+    const std::string_view message  = "benchmark message";
+    const PreparedMessage  prepared = PreparedMessage::prepare(asBytes(message), tags);
+
+    BENCHMARK("blsSignHash") {
+        return node.blsSignHash(asBytes(message), tags);
+    };
+
+    BENCHMARK("signPrepared") {
+        return node.signPrepared(prepared);
+    };
+
+    for (size_t windowBits : {size_t{4}, size_t{8}}) {
+        PreparedMessage precomputed = prepared;
+        precomputed.table           = std::make_shared<const G2FixedBaseTable>(prepared.Hm, windowBits);
+        BENCHMARK("signPrepared, precomputed table, w = " + std::to_string(windowBits)) {
+            return node.signPrepared(precomputed);
+        };
+    }
+
+    BENCHMARK("PreparedMessage::precompute (10,000 signers)") {
+        PreparedMessage precomputed = prepared;
+        return precomputed.precompute(10'000).table;
+    };
+}
+
+TEST_CASE("Key generation", "[benchmark][bls]") {
+    ServiceNodeList snl(1, /*signingThreads*/ 1); // NOTE: Initialises the curve and generator
+
+    mcl::bn::G1 generator;
+    bool        mapped = false;
+    mcl::bn::mapToG1(&mapped, generator, 1);
+
+    BENCHMARK("ServiceNode, bls::SecretKey::getPublicKey") {
+        return ServiceNode(1);
+    };
+
+    for (size_t nodes : {size_t{100}, size_t{10'000}}) {
+        const G1FixedBaseTable table{generator, G1FixedBaseTable::optimalWindowBits(nodes)};
+        BENCHMARK("ServiceNode, generator table sized for N = " + std::to_string(nodes)) {
+            return ServiceNode(1, table);
+        };
+    }
+
+    // NOTE: Below `GENERATOR_TABLE_MIN_NODES` the list is created without a
+    // table so the remaining nodes are derived with getPublicKey
+    BENCHMARK("ServiceNodeList, N = 1,000, bls::SecretKey::getPublicKey") {
+        ServiceNodeList list(1, /*signingThreads*/ 1);
+        for (size_t i = list.nodes.size(); i < 1'000; i++)
+            list.addNode();
+        return list.nodes.size();
+    };
+
+    BENCHMARK("ServiceNodeList, N = 1,000, generator table") {
+        return ServiceNodeList(1'000, /*signingThreads*/ 1).nodes.size();
+    };
+}
+
+TEST_CASE("Aggregate signatures", "[benchmark][bls]") {
+    // NOTE: Single threaded so the results measure the cost of aggregation
+    // rather than the number of cores on the machine running the benchmark
+    ServiceNodeList   snl(10'000, /*signingThreads*/ 1);
+    const DomainTags& tags    = snl.domainTags(CHAIN_ID, CONTRACT_ADDRESS);
+    const std::string message = "benchmark message";
+
+    for (size_t signers : {size_t{10}, size_t{100}, size_t{1'000}, size_t{10'000}}) {
+        std::vector<int64_t> indices;
+        indices.reserve(signers);
+        for (size_t index = 0; index < signers; index++)
+            indices.push_back(static_cast<int64_t>(index));
+
+        snl.signingMode = ServiceNodeList::SigningMode::AggregateSecretKey;
+        BENCHMARK("aggregateSignaturesFromIndices, summed secret key, N = " + std::to_string(signers)) {
+            return snl.aggregateSignaturesFromIndices(message, indices, tags);
+        };
+
+        snl.signingMode          = ServiceNodeList::SigningMode::PerNode;
+        snl.precomputeMinSigners = SIZE_MAX;
+        BENCHMARK("aggregateSignaturesFromIndices, per node, mulCT, N = " + std::to_string(signers)) {
+            return snl.aggregateSignaturesFromIndices(message, indices, tags);
+        };
+
+        snl.precomputeMinSigners = 0;
+        BENCHMARK("aggregateSignaturesFromIndices, per node, precomputed table, N = " + std::to_string(signers)) {
+            return snl.aggregateSignaturesFromIndices(message, indices, tags);
+        };
+    }
+}
+
+TEST_CASE("Serialise keys and signatures", "[benchmark][bls]") {
+    ServiceNodeList      snl(1, /*signingThreads*/ 1);
+    const ServiceNode&   node      = snl.nodes[0];
+    const std::string    pubkeyHex = node.getPublicKeyHex();
+    const bls::Signature signature = node.blsSignHash(asBytes("benchmark message"), CHAIN_ID, CONTRACT_ADDRESS);
+    const std::string    sigHex    = utils::SignatureToHex(signature);
+    const auto           pubkey    = utils::BLSPublicKeyToBytes(node.getPublicKey());
+
+    BENCHMARK("BLSPublicKeyToHex") {
+        return utils::BLSPublicKeyToHex(node.getPublicKey());
+    };
+
+    BENCHMARK("HexToBLSPublicKey") {
+        return utils::HexToBLSPublicKey(pubkeyHex);
+    };
+
+    BENCHMARK("BytesToBLSPublicKey") {
+        return utils::BytesToBLSPublicKey(pubkey);
+    };
+
+    BENCHMARK("SignatureToHex") {
+        return utils::SignatureToHex(signature);
+    };
+
+    BENCHMARK("HexToSignature") {
+        return utils::HexToSignature(sigHex);
+    };
+}
@@ -1,23 +1,69 @@
 set(sources
+    src/abi.cpp
     src/basic.cpp
+    src/contract_events.cpp
+    src/contract_state_file.cpp
+    src/contract_sync.cpp
     src/erc20_contract.cpp
+    src/service_node_contribution_contract.cpp
     src/service_node_rewards_contract.cpp
     src/service_node_list.cpp
     src/ec_utils.cpp
+    src/json_rpc_batch.cpp
+    src/liquidator.cpp
+    src/multicall.cpp
+    src/oxend_rpc.cpp
+    src/rewards_ledger.cpp
+    src/rpc_provider.cpp
+    src/transaction_pipeline.cpp
+    src/uint256.cpp
+    src/worker_pool.cpp
 )
 
 set(headers
+    include/service_node_rewards/abi.hpp
     include/service_node_rewards/basic.hpp
     include/service_node_rewards/config.hpp
+    include/service_node_rewards/contract_events.hpp
+    include/service_node_rewards/contract_state_file.hpp
+    include/service_node_rewards/contract_sync.hpp
     include/service_node_rewards/ec_utils.hpp
     include/service_node_rewards/erc20_contract.hpp
+    include/service_node_rewards/json_rpc_batch.hpp
+    include/service_node_rewards/liquidator.hpp
+    include/service_node_rewards/multicall.hpp
+    include/service_node_rewards/oxend_rpc.hpp
+    include/service_node_rewards/rewards_ledger.hpp
+    include/service_node_rewards/rpc_provider.hpp
+    include/service_node_rewards/selector.hpp
+    include/service_node_rewards/service_node_contribution_contract.hpp
     include/service_node_rewards/service_node_rewards_contract.hpp
     include/service_node_rewards/service_node_list.hpp
+    include/service_node_rewards/transaction_pipeline.hpp
+    include/service_node_rewards/uint256.hpp
+    include/service_node_rewards/worker_pool.hpp
 )
 
 set(test_sources
+  src/abi.cpp
   src/basic.cpp
   src/basic_ethereum.cpp
+  src/contract_events.cpp
+  src/contract_state_file.cpp
   src/rewards_contract.cpp
   src/hash.cpp
+  src/json_rpc_batch.cpp
+  src/liquidator.cpp
+  src/multicall.cpp
+  src/rewards_ledger.cpp
+  src/rpc_provider.cpp
+  src/service_node_contribution_contract.cpp
+  src/service_node_list.cpp
+  src/transaction_pipeline.cpp
+  src/uint256.cpp
+)
+
+set(benchmark_sources
+  src/abi.cpp
+  src/bls.cpp
 )
@@ -24,6 +24,7 @@ Include(FetchContent)
 
 option(${PROJECT_NAME}_ENABLE_UNIT_TESTING "Enable unit tests for the projects (from the `test` subfolder)." ON)
 option(${PROJECT_NAME}_USE_CATCH2 "Use the Catch2 project for creating unit tests." ON)
+option(${PROJECT_NAME}_ENABLE_BENCHMARKS "Build the benchmarks (from the `benchmark` subfolder), they do not require a devnet." OFF)
 
 #
 # Static analyzers
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "service_node_rewards/uint256.hpp"
+
+/// Solidity ABI encoder for contract call data. Arguments are written as hex
+/// directly into a single string that is sized up front from the number of
+/// 32 byte words the caller expects to write, so building call data performs
+/// one allocation regardless of the number of arguments or array elements.
+///
+/// The encoder writes words in the order they are appended. Dynamic
+/// arguments (arrays, bytes) are encoded by writing an `offset` into the head
+/// and appending the tail after the last head word, e.g. for
+/// `f(uint256 a, uint64[] b)`:
+///
+///   AbiEncoder abi{selector, 2 + AbiEncoder::uintArrayWords(b.size())};
+///   abi.uint(a).offset(2).uintArray(b);
+///   tx.data = std::move(abi).str();
+class AbiEncoder {
+public:
+    static constexpr size_t WORD_SIZE     = 32;
+    static constexpr size_t WORD_HEX_SIZE = WORD_SIZE * 2;
+
+    /// Start call data with the 4 byte function `selector` (hex with or
+    /// without a 0x prefix) and reserve space for `wordCount` argument words.
+    /// Writing more than `wordCount` words is permitted but will reallocate.
+    AbiEncoder(std::string_view selector, size_t wordCount);
+
+    /// Number of words a `uint64[]` of `count` elements occupies in the tail
+    static constexpr size_t uintArrayWords(size_t count) { return 1 + count; }
+
+    /// Number of words a `bytes` of `size` bytes occupies in the tail
+    static constexpr size_t bytesWords(size_t size) { return 1 + (size + WORD_SIZE - 1) / WORD_SIZE; }
+
+    AbiEncoder& uint(uint64_t value);
+    AbiEncoder& uint(const Uint256& value);
+
+    /// 20 byte address in hex with or without a 0x prefix, left padded to a
+    /// word. Throws if the hex is malformed.
+    AbiEncoder& address(std::string_view hex);
+
+    /// Static words that are already ABI encoded as hex (e.g. the output of
+    /// `utils::BLSPublicKeyToHex` or `utils::SignatureToHex`). Throws if the
+    /// hex is not a whole number of words.
+    AbiEncoder& words(std::string_view hex);
+
+    /// Raw `payload` left padded with zeros to `wordCount` words, e.g. an
+    /// ed25519 key into a `uint256`. Throws if `payload` does not fit.
+    AbiEncoder& leftPadded(std::span<const uint8_t> payload, size_t wordCount);
+
+    /// Offset of a dynamic argument whose tail begins after `headWords` words
+    /// of argument head. The offset is measured from the start of the
+    /// arguments, i.e. excludes the selector.
+    AbiEncoder& offset(size_t headWords);
+
+    /// Tail of a dynamic `uint64[]`, the length followed by the elements.
+    AbiEncoder& uintArray(std::span<const uint64_t> values);
+
+    /// Tail of a dynamic `bytes`, the length followed by the right padded data
+    AbiEncoder& bytes(std::span<const uint8_t> payload);
+
+    /// Tail of a dynamic `bytes` given as hex (with or without a 0x prefix),
+    /// e.g. the call data of another encoder. Throws if the hex is malformed.
+    AbiEncoder& bytesHex(std::string_view hex);
+
+    /// The 0x prefixed call data
+    const std::string& str() const& { return data; }
+    std::string        str() && { return std::move(data); }
+
+private:
+    char* reserveWords(size_t count);
+
+    std::string data;
+};
+
+/// Solidity ABI decoder that reads words of hex encoded return data in place.
+/// The decoder is a view over the hex, it does not copy or allocate, values
+/// are decoded directly into the fixed size outputs of the accessors.
+///
+/// Words are addressed by index from the start of the view. A dynamic value
+/// (tuple with dynamic members, array, bytes) is stored as an offset relative
+/// to the start of the enclosing view, `tail` resolves the offset into a new
+/// view starting at the dynamic data, e.g. for a returned `uint64[]`:
+///
+///   AbiDecoder array = AbiDecoder{result}.tail(0);
+///   for (size_t i = 0; i < array.uint64(0); i++)
+///       values.push_back(array.uint64(1 + i));
+///
+/// Accessors throw if the word is out of bounds or if the value does not fit
+/// the requested type.
+class AbiDecoder {
+public:
+    /// `hex` with or without a 0x prefix. It must be a whole number of words
+    /// and must outlive the decoder.
+    explicit AbiDecoder(std::string_view hex);
+
+    size_t words() const { return hex.size() / AbiEncoder::WORD_HEX_SIZE; }
+
+    /// View starting at the dynamic data whose offset is stored in `index`
+    AbiDecoder tail(size_t index) const;
+
+    /// View starting at word `index`, e.g. the elements of an array after its
+    /// length which is the origin of the offsets of dynamic elements.
+    AbiDecoder slice(size_t index) const;
+
+    /// Hex of the dynamic `bytes` whose offset is stored in `index`
+    std::string_view bytesHex(size_t index) const;
+
+    /// Hex of `count` words starting at `index`
+    std::string_view wordsHex(size_t index, size_t count) const;
+
+    uint64_t                uint64(size_t index) const;
+    Uint256                 uint256(size_t index) const;
+    std::array<uint8_t, 20> address(size_t index) const;
+    std::array<uint8_t, 32> bytes32(size_t index) const;
+
+private:
+    AbiDecoder() = default;
+    std::string_view word(size_t index) const;
+
+    std::string_view hex;
+};
@@ -68,6 +68,10 @@ constexpr std::string_view network_type_to_string(network_type t) {
 
 // Various configuration defaults and network-dependent settings
 namespace config {
+    // NOTE: Multicall3 is deployed to the same address on every network, the
+    // local test deployment (scripts/deploy-local-test.js) installs it there too
+    inline constexpr std::string_view MULTICALL3_ADDRESS = "0xcA11bde05977b3631167028862bE2a173976CA11";
+
     namespace arbitrum {
         inline constexpr std::string_view RPC_URL = "https://arb1.arbitrum.io/rpc";
         inline constexpr uint32_t CHAIN_ID = 42161;
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "service_node_rewards/selector.hpp"
+#include "service_node_rewards/service_node_rewards_contract.hpp"
+#include "service_node_rewards/uint256.hpp"
+
+struct NewServiceNodeEvent {
+    uint64_t                      serviceNodeID;
+    std::array<unsigned char, 20> initiator;
+    bls::PublicKey                pubkey;
+    std::array<unsigned char, 32> ed25519Pubkey;
+    uint16_t                      fee;
+    std::vector<Contributor>      contributors;
+};
+
+struct NewSeededServiceNodeEvent {
+    uint64_t                      serviceNodeID;
+    bls::PublicKey                pubkey;
+    std::array<unsigned char, 32> ed25519Pubkey;
+};
+
+struct ServiceNodeExitRequestEvent {
+    uint64_t                      serviceNodeID;
+    std::array<unsigned char, 20> contributor;
+    bls::PublicKey                pubkey;
+};
+
+struct ServiceNodeExitEvent {
+    uint64_t                      serviceNodeID;
+    std::array<unsigned char, 20> operatorAddress;
+    Uint256                       returnedAmount;
+    bls::PublicKey                pubkey;
+};
+
+struct ServiceNodeLiquidatedEvent {
+    uint64_t                      serviceNodeID;
+    std::array<unsigned char, 20> operatorAddress;
+    bls::PublicKey                pubkey;
+};
+
+struct RewardsBalanceUpdatedEvent {
+    std::array<unsigned char, 20> recipient;
+    Uint256                       amount;
+    Uint256                       previousBalance;
+};
+
+struct RewardsClaimedEvent {
+    std::array<unsigned char, 20> recipient;
+    Uint256                       amount;
+};
+
+/// A log emitted by the rewards contract that changes the service node list
+/// or the recipients' balances, decoded from an `eth_getLogs` response.
+/// Events that only change the contract's configuration (e.g.
+/// `ClaimCycleUpdated`) are not decoded.
+struct ContractEvent {
+    using Data = std::variant<
+            NewServiceNodeEvent,
+            NewSeededServiceNodeEvent,
+            ServiceNodeExitRequestEvent,
+            ServiceNodeExitEvent,
+            ServiceNodeLiquidatedEvent,
+            RewardsBalanceUpdatedEvent,
+            RewardsClaimedEvent>;
+
+    static constexpr inline EventTopic NEW_SERVICE_NODE_V2{"NewServiceNodeV2(uint64,address,(uint256,uint256),(uint256,uint256,uint256,uint16),((address,address),uint256)[])"};
+    static constexpr inline EventTopic NEW_SEEDED_SERVICE_NODE{"NewSeededServiceNode(uint64,(uint256,uint256),uint256)"};
+    static constexpr inline EventTopic SERVICE_NODE_EXIT_REQUEST{"ServiceNodeExitRequest(uint64,address,(uint256,uint256))"};
+    static constexpr inline EventTopic SERVICE_NODE_EXIT{"ServiceNodeExit(uint64,address,uint256,(uint256,uint256))"};
+    static constexpr inline EventTopic SERVICE_NODE_LIQUIDATED{"ServiceNodeLiquidated(uint64,address,(uint256,uint256))"};
+    static constexpr inline EventTopic REWARDS_BALANCE_UPDATED{"RewardsBalanceUpdated(address,uint256,uint256)"};
+    static constexpr inline EventTopic REWARDS_CLAIMED{"RewardsClaimed(address,uint256)"};
+
+    uint64_t    blockNumber;
+    uint64_t    logIndex;
+    std::string transactionHash;
+    Data        data;
+
+    /// Decode a log object from `eth_getLogs`. Returns an empty optional if
+    /// the log is not one of the events above and throws if the log is
+    /// malformed.
+    static std::optional<ContractEvent> decode(const nlohmann::json& log);
+};
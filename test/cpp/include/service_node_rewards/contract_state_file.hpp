@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+#include "service_node_rewards/contract_sync.hpp"
+#include "service_node_rewards/uint256.hpp"
+
+/// Compact binary snapshot of a `ContractStateMirror` that is memory mapped
+/// when loaded so a process can start from the snapshot and only catch up
+/// the events emitted since `blockHeight` instead of re-reading every node
+/// from the contract.
+///
+/// The file is the header followed by the node, contributor and recipient
+/// record arrays. Every record is a multiple of 8 bytes so each array is
+/// naturally aligned within the (page aligned) mapping and integers are
+/// stored little-endian, a `Uint256` as its four limbs. Public keys are
+/// stored as their big-endian affine coordinates
+/// (`utils::BLSPublicKeyToBytes`) so no hex parsing is required to restore
+/// them.
+///
+/// ```
+/// ContractStateFile::write(path, mirror, aggregatePubkey, syncer.checkpoint().value());
+/// ...
+/// ContractStateFile   file{path};
+/// ContractStateMirror mirror = file.toMirror();
+/// syncer.setCheckpoint(file.header().blockHeight);
+/// syncer.sync(mirror);
+/// ```
+class ContractStateFile {
+public:
+    static constexpr std::array<char, 8> MAGIC   = {'S', 'N', 'R', 'S', 'T', 'A', 'T', 'E'};
+    static constexpr uint32_t            VERSION = 2;
+
+    struct Header {
+        std::array<char, 8>     magic;
+        uint32_t                version;
+        uint32_t                reserved;
+        uint64_t                blockHeight;
+        uint64_t                nodeCount;
+        uint64_t                contributorCount;
+        uint64_t                recipientCount;
+        std::array<uint8_t, 64> aggregatePubkey;
+    };
+
+    /// Nodes are stored in the contract's list order, `next` and `prev` are
+    /// the IDs of the neighbouring nodes (0 being the list's sentinel).
+    struct NodeRecord {
+        uint64_t                id;
+        uint64_t                next;
+        uint64_t                prev;
+        std::array<uint8_t, 64> pubkey;
+        std::array<uint8_t, 32> ed25519Pubkey;
+        std::array<uint8_t, 20> operatorAddress;
+        uint16_t                fee;
+        uint8_t                 leaveRequested;
+        uint8_t                 reserved;
+        uint32_t                contributorBegin; // NOTE: Index into the contributor records
+        uint32_t                contributorCount;
+    };
+
+    struct ContributorRecord {
+        std::array<uint8_t, 20> address;
+        std::array<uint8_t, 20> beneficiaryAddress;
+        Uint256                 amount;
+    };
+
+    struct RecipientRecord {
+        std::array<uint8_t, 20> address;
+        std::array<uint8_t, 4>  reserved;
+        Uint256                 rewards;
+        Uint256                 claimed;
+    };
+
+    /// Serialise `mirror` and replace the file at `path`. The snapshot is
+    /// written to a temporary file, flushed to disk and then renamed over
+    /// `path`, readers never observe a partially written snapshot.
+    static void write(const std::filesystem::path& path, const ContractStateMirror& mirror, const bls::PublicKey& aggregatePubkey, uint64_t blockHeight);
+
+    /// Map the snapshot at `path` read-only. Throws if the file can't be
+    /// mapped, has a different magic or version or its record counts don't
+    /// match its size.
+    explicit ContractStateFile(const std::filesystem::path& path);
+    ~ContractStateFile();
+
+    ContractStateFile(ContractStateFile&& other) noexcept;
+    ContractStateFile& operator=(ContractStateFile&& other) noexcept;
+    ContractStateFile(const ContractStateFile&)            = delete;
+    ContractStateFile& operator=(const ContractStateFile&) = delete;
+
+    const Header&                      header() const { return *reinterpret_cast<const Header*>(mapping); }
+    std::span<const NodeRecord>        nodes() const;
+    std::span<const ContributorRecord> contributors() const;
+    std::span<const RecipientRecord>   recipients() const;
+
+    /// Restore the mirror the snapshot was written from
+    ContractStateMirror toMirror() const;
+    bls::PublicKey      aggregatePubkey() const;
+
+private:
+    const unsigned char* mapping = nullptr;
+    size_t               size    = 0;
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "service_node_rewards/contract_events.hpp"
+
+struct MirroredServiceNode {
+    std::array<unsigned char, 20> operatorAddress; // NOTE: Zero for nodes seeded by the contract owner
+    bls::PublicKey                pubkey;
+    std::array<unsigned char, 32> ed25519Pubkey;
+    uint16_t                      fee;
+    std::vector<Contributor>      contributors;
+    bool                          leaveRequested;
+};
+
+/// Local copy of the rewards contract's service node list and recipient
+/// balances that is maintained purely from the contract's events.
+struct ContractStateMirror {
+    // NOTE: The contract allocates IDs incrementally and appends new nodes to
+    // the tail of its list, so ID order is also the contract's list order.
+    std::map<uint64_t, MirroredServiceNode>            nodes;
+    std::map<std::array<unsigned char, 20>, Recipient> recipients;
+
+    /// Apply `event` to the mirror. Events must be applied in the order they
+    /// were emitted, i.e. sorted by block number then log index.
+    void apply(const ContractEvent& event);
+};
+
+/// Incrementally synchronises a `ContractStateMirror` with the rewards
+/// contract by paging through `eth_getLogs` from the last block that was
+/// applied. The checkpoint (the last block whose events have all been
+/// applied) is only advanced in memory alongside the mirror. It is persisted
+/// together with the mirror as the `blockHeight` of a `ContractStateFile`, so
+/// a restarted process resumes from exactly the state that was saved.
+class ContractEventSyncer {
+public:
+    /// `startBlock` is the block to begin syncing from when no checkpoint has
+    /// been set, typically the contract's deployment block.
+    ContractEventSyncer(std::string url, std::string contractAddress, uint64_t startBlock = 0);
+
+    /// Apply the events emitted after the checkpoint up to `confirmations`
+    /// blocks behind the chain head to `mirror`. Returns the number of events
+    /// applied. If a page fails the checkpoint and `mirror` still agree on
+    /// the pages applied before it.
+    size_t sync(ContractStateMirror& mirror, uint64_t confirmations = 0);
+
+    /// The last block applied, empty if nothing has been synced yet
+    std::optional<uint64_t> checkpoint() const { return lastBlock; }
+
+    /// Resume syncing after `block`, e.g. the block height of the snapshot
+    /// the mirror was restored from
+    void setCheckpoint(uint64_t block);
+
+    std::string url;
+    std::string contractAddress;
+
+    /// Number of blocks requested per `eth_getLogs` call. Providers cap the
+    /// number of logs or the block range of a query, when a page is rejected
+    /// it is retried with half the range and the smaller range is kept.
+    uint64_t pageSize = 2000;
+
+private:
+    std::optional<uint64_t> lastBlock;
+    uint64_t                startBlock;
+};
@@ -14,13 +14,20 @@
 #undef MCLBN_NO_AUTOLINK
 #pragma GCC diagnostic pop
 
+#include <array>
 #include <span>
+#include <string_view>
 #include <oxenc/hex.h>
 
 namespace utils
 {
+    std::array<uint8_t, 64>       BLSPublicKeyToBytes(const bls::PublicKey& publicKey);
     std::string                   BLSPublicKeyToHex(const bls::PublicKey& publicKey);
     bls::PublicKey                HexToBLSPublicKey(std::string_view hex);
+
+    /// Reverse of `BLSPublicKeyToBytes`, the big-endian affine X and Y
+    /// coordinates of the key. Throws if a coordinate is not a field element.
+    bls::PublicKey                BytesToBLSPublicKey(std::span<const uint8_t, 64> bytes);
     std::string                   SignatureToHex(bls::Signature sig);
     std::array<unsigned char, 32> HashModulus(std::string message);
 
@@ -45,4 +52,56 @@ namespace utils
     /// use keccak256 to align with our Solidity implementation of expand
     /// message.
     void ExpandMessageXMDKeccak256(std::span<uint8_t> out, std::span<const uint8_t> msg, std::span<const uint8_t> dst);
+
+    /// Build the 32 byte domain separation tag the rewards contract derives
+    /// for `baseTag` in `buildTag`, e.g.
+    /// `keccak256(abi.encodePacked(baseTag, chainID, contractAddress))`
+    std::array<uint8_t, 32> BuildTag(std::string_view baseTag, uint32_t chainID, std::string_view contractAddress);
+
+    /// Map `msg` onto G2 via try-and-increment, equivalent to Solidity's
+    /// `BN256G2.mapToG2`. The result is not multiplied by the cofactor.
+    mcl::bn::G2 MapToG2(std::span<const uint8_t> msg, std::span<const uint8_t> hashToG2Tag);
+
+    /// Map `msg` onto G2 and clear the cofactor, equivalent to Solidity's
+    /// `BN256G2.hashToG2`. This is the `Hm` that is signed and verified.
+    mcl::bn::G2 HashToG2(std::span<const uint8_t> msg, std::span<const uint8_t> hashToG2Tag);
+
+    /// Reverse of `SignatureToHex`, throws if the hex is malformed or the
+    /// point is not on the curve.
+    bls::Signature HexToSignature(std::string_view hex);
+
+    /// Subtract the `nonSignerPubkeys` from the `aggregatePubkey` to derive
+    /// the public key the signature must verify against. This is the same
+    /// derivation as `validateSignatureOrRevert` in the rewards contract.
+    bls::PublicKey SignersPubkey(const bls::PublicKey& aggregatePubkey, std::span<const bls::PublicKey> nonSignerPubkeys);
+
+    /// Verify `signature` over `Hm` against `pubkey` with the pairing check
+    /// `e(G1, signature) == e(pubkey, Hm)` that the contract executes. The
+    /// public key generator must have been set (e.g. by constructing a
+    /// ServiceNodeList) prior to calling this.
+    bool VerifySignature(const mcl::bn::G2& Hm, const bls::Signature& signature, const bls::PublicKey& pubkey);
+
+    /// Verify `signature` over `msg` exactly as `validateSignatureOrRevert`
+    /// does, the signers' key is derived from the contract's aggregate and the
+    /// public keys of the non-signers.
+    bool VerifyAggregateSignature(std::span<const uint8_t> msg,
+                                  std::span<const uint8_t> hashToG2Tag,
+                                  const bls::Signature& signature,
+                                  const bls::PublicKey& aggregatePubkey,
+                                  std::span<const bls::PublicKey> nonSignerPubkeys);
+
+    struct SignatureCheck {
+        mcl::bn::G2    Hm;
+        bls::Signature signature;
+        bls::PublicKey pubkey;
+    };
+
+    /// Verify many signatures at once. Each check is weighted by a random
+    /// scalar `r_i` and the combination is verified with one multi-pairing,
+    ///
+    ///   e(G1, sum(r_i * signature_i)) == prod(e(r_i * pubkey_i, Hm_i))
+    ///
+    /// Returns true if every signature is valid. A false result does not
+    /// identify the invalid signature, verify them individually to find it.
+    bool VerifySignatureBatch(std::span<const SignatureCheck> checks);
 }
@@ -1,17 +1,36 @@
 #pragma once
 
 #include <memory>
+#include <span>
 #include <string>
+#include <string_view>
+#include <vector>
 
+#include "service_node_rewards/json_rpc_batch.hpp"
+#include "service_node_rewards/rpc_provider.hpp"
+#include "service_node_rewards/selector.hpp"
+#include "service_node_rewards/uint256.hpp"
 #include "ethyl/provider.hpp"
 #include "ethyl/transaction.hpp"
 
 class ERC20Contract {
 public:
+    // NOTE: Function selectors of the contract, hashed at compile time
+    static constexpr inline FunctionSelector APPROVE   {"approve(address,uint256)"};
+    static constexpr inline FunctionSelector TRANSFER  {"transfer(address,uint256)"};
+    static constexpr inline FunctionSelector BALANCE_OF{"balanceOf(address)"};
+
     // Function to call the 'approve' method of the ERC20 token contract
-    ethyl::Transaction approve(const std::string& spender, uint64_t amount);
-    ethyl::Transaction transfer(const std::string& to, uint64_t amount);
-    uint64_t balanceOf(const std::string& address);
+    ethyl::Transaction approve(const std::string& spender, const Uint256& amount);
+    ethyl::Transaction transfer(const std::string& to, const Uint256& amount);
+    Uint256 balanceOf(const std::string& address);
+
+    /// Retrieve `balanceOf` for every address through `batch` (which must
+    /// have no requests queued), returned in the same order as `addresses`.
+    std::vector<Uint256> balanceOf(JsonRpcBatch& batch, std::span<const std::string> addresses);
+
+    /// Decode the ABI encoded return value of `balanceOf`
+    static Uint256 decodeBalanceOf(std::string_view callResultHex);
 
     /// Address of the ERC20 contract that must be set to the address of the
     /// contract on the blockchain for the functions to succeed. If the contract
@@ -25,4 +44,9 @@ public:
     std::shared_ptr<ethyl::Provider> client_ptr{ethyl::Provider::make_provider()};
     ethyl::Provider& provider{*client_ptr};
 
+    /// Provider the contract's reads are made through, by default `provider`.
+    /// Replace it to read from another source, e.g. a `ReplayRpcProvider` to
+    /// serve recorded responses without a node.
+    std::shared_ptr<RpcProvider> rpc{std::make_shared<EthylRpcProvider>(client_ptr)};
+
 };
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+/// Queue of JSON-RPC requests that are sent to the node as batches (an array
+/// of requests in one HTTP request) to amortise the round-trip over many
+/// calls, e.g. retrieving `serviceNodes(id)` for every node on startup.
+///
+/// Requests are queued with `request` or `ethCall` which return the index of
+/// the request's result in the array returned by `execute`. The node may
+/// answer a batch in any order, results are matched back to their request by
+/// the JSON-RPC `id`.
+class JsonRpcBatch {
+public:
+    /// Nodes limit the number of requests in a batch (e.g. geth defaults to
+    /// 1000), queues larger than `maxBatchSize` are split into multiple
+    /// batches when executed.
+    explicit JsonRpcBatch(std::string url, size_t maxBatchSize = 1000);
+
+    size_t request(std::string_view method, nlohmann::json params);
+
+    /// Queue an `eth_call` of `data` against the contract at `to`
+    size_t ethCall(std::string_view to, std::string_view data, std::string_view blockTag = "latest");
+
+    size_t size() const { return pending.size(); }
+
+    /// Send the queued requests and clear the queue. The results are returned
+    /// in the order the requests were queued. Throws if the node could not be
+    /// reached or any request returned an error.
+    std::vector<nlohmann::json> execute();
+
+    /// As `execute` but a request that returned an error does not throw, the
+    /// JSON-RPC error object is written into `errors` at the index of the
+    /// request instead (requests that succeeded have a null error).
+    std::vector<nlohmann::json> execute(std::vector<nlohmann::json>& errors);
+
+    /// Match the responses of a batch in `body` to the requests that were
+    /// assigned consecutive ids starting at `firstID`, writing each result
+    /// into `results` at the index of its request. Throws if a response is
+    /// missing. Error responses are written into `errors` if it's non-empty
+    /// (it must then be the same size as `results`), otherwise they throw.
+    static void parseResponse(std::string_view body, uint64_t firstID, std::span<nlohmann::json> results, std::span<nlohmann::json> errors = {});
+
+    /// Sends a batch's request body to the node and returns the response
+    /// body. Batches are POSTed to `url` when unset, tests set this to answer
+    /// batches without a node.
+    using Transport = std::function<std::string(const std::string& body)>;
+
+    std::string url;
+    size_t      maxBatchSize;
+    Transport   transport;
+
+private:
+    std::vector<nlohmann::json> send(std::vector<nlohmann::json>* errors);
+
+    std::vector<nlohmann::json> pending;
+    uint64_t                    nextID = 1;
+};
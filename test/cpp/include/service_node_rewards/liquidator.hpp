@@ -0,0 +1,92 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "service_node_rewards/oxend_rpc.hpp"
+#include "service_node_rewards/service_node_rewards_contract.hpp"
+#include "service_node_rewards/transaction_pipeline.hpp"
+#include "service_node_rewards/worker_pool.hpp"
+#include "ethyl/transaction.hpp"
+
+/// A node in oxend's liquidation list
+struct LiquidationCandidate {
+    std::string serviceNodePubkey; // NOTE: oxend's service node pubkey (hex)
+    std::string blsPubkey;         // NOTE: 128 lower-case hex characters, without a 0x prefix
+    uint64_t    liquidationHeight;
+};
+
+/// Removes the nodes oxend reports as liquidatable from the rewards contract.
+///
+/// Each round reads the contract's node list and oxend's liquidation list
+/// concurrently, requests the network's liquidation signature for every
+/// liquidatable node in parallel and submits all of the liquidations through
+/// a `TransactionPipeline` so a backlog is cleared in a few round trips
+/// instead of one transaction at a time.
+///
+/// Nodes whose liquidation was submitted are not resubmitted whilst they
+/// remain in the contract for `pendingTimeout`, the transaction may still be
+/// waiting to be mined or another liquidator may have raced it. A dry run
+/// submits nothing so every round rebuilds the liquidations.
+///
+/// ```
+/// HttpOxendRpc        oxend{"http://127.0.0.1:22023"};
+/// TransactionPipeline pipeline{signer, seckey, url};
+/// Liquidator          liquidator{rewards_contract, oxend, &pipeline};
+/// liquidator.run(30s, [](const Liquidator::Round& round) { return true; });
+/// ```
+class Liquidator {
+public:
+    struct Liquidation {
+        LiquidationCandidate        candidate;
+        ethyl::Transaction          tx{"", 0, 0}; // NOTE: Unset if the signature could not be obtained
+        std::string                 error;        // NOTE: Why the node was not liquidated, empty on success
+        TransactionPipeline::Result result;       // NOTE: Unset for a dry run
+    };
+
+    struct Round {
+        uint64_t                 height        = 0;
+        bool                     heightChanged = false; // NOTE: Nothing is liquidated until oxend's height advances
+        size_t                   candidates    = 0;     // NOTE: Size of oxend's liquidation list
+        size_t                   skipped       = 0;     // NOTE: Not yet liquidatable, not in the contract or pending
+        std::vector<Liquidation> liquidations;
+        std::string              error; // NOTE: Set by `run` if the round failed, e.g. oxend could not be reached
+    };
+
+    /// `contract` and `oxend` must outlive the liquidator. If `pipeline` is
+    /// null the liquidations are built but not sent (a dry run).
+    /// `maxConcurrentRequests` bounds the number of signatures requested from
+    /// oxend at once.
+    Liquidator(ServiceNodeRewardsContract& _contract, OxendRpc& _oxend, TransactionPipeline* _pipeline, size_t maxConcurrentRequests = 16);
+
+    /// Liquidate every node that is currently liquidatable and wait for the
+    /// transactions to be mined (or `submitTimeout` to elapse).
+    Round liquidate();
+
+    /// Call `liquidate` every `interval` until `onRound` returns false. A
+    /// round that throws is passed to `onRound` with its `error` set and the
+    /// next round is attempted after `interval`.
+    void run(std::chrono::milliseconds interval, const std::function<bool(const Round&)>& onRound);
+
+    std::chrono::milliseconds submitTimeout  = std::chrono::seconds(60);
+    std::chrono::milliseconds pendingTimeout = std::chrono::minutes(5);
+
+private:
+    /// Request the liquidation signature for `candidate` and build the
+    /// transaction, sets `error` if oxend refused to sign.
+    Liquidation prepare(const LiquidationCandidate& candidate);
+
+    ServiceNodeRewardsContract& contract;
+    OxendRpc&                   oxend;
+    TransactionPipeline*        pipeline;
+    WorkerPool                  requests;
+    uint64_t                    lastHeight = 0;
+
+    /// BLS pubkey of the nodes with a submitted liquidation to the time it was submitted
+    std::map<std::string, std::chrono::steady_clock::time_point> pending;
+};
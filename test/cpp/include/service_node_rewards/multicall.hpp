@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "service_node_rewards/rpc_provider.hpp"
+#include "service_node_rewards/selector.hpp"
+
+/// Aggregates view calls into a single `eth_call` of Multicall3's `aggregate3`
+/// so that every call is evaluated against the same block in one request.
+///
+/// Calls are queued with `add` which returns the index of the call's result in
+/// the array returned by `execute`. The call data of the contract read calls
+/// can be built with the `...CallData` functions of the contract classes and
+/// the return data decoded with their `decode...` functions.
+class Multicall3 {
+public:
+    static constexpr inline FunctionSelector AGGREGATE3{"aggregate3((address,bool,bytes)[])"};
+
+    struct Call {
+        std::string target;
+        std::string callData;
+        bool        allowFailure;
+    };
+
+    struct Result {
+        bool        success;
+        std::string returnData; // NOTE: Hex without a 0x prefix
+    };
+
+    /// `address` of the Multicall3 contract, see config::MULTICALL3_ADDRESS
+    explicit Multicall3(std::string address);
+
+    /// Queue a call of `callData` (hex) against the contract at `target`. If
+    /// `allowFailure` is false and the call reverts the whole aggregate
+    /// reverts.
+    size_t add(std::string_view target, std::string callData, bool allowFailure = false);
+
+    size_t size() const { return calls.size(); }
+
+    /// Encode the queued calls as the call data of `aggregate3`
+    std::string encode() const;
+
+    /// Decode the ABI encoded `Result[]` returned by `aggregate3`
+    static std::vector<Result> decode(std::string_view callResultHex);
+
+    /// Send the queued calls in one `eth_call` and clear the queue. The
+    /// results are returned in the order the calls were queued.
+    std::vector<Result> execute(RpcProvider& provider);
+
+    std::string address;
+
+private:
+    std::vector<Call> calls;
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <nlohmann/json.hpp>
+
+#include "service_node_rewards/service_node_list.hpp"
+
+/// JSON-RPC interface of an oxend node, the source of the liquidation list
+/// and the network's liquidation signatures. Implementations must be safe to
+/// call from multiple threads at once.
+class OxendRpc {
+public:
+    virtual ~OxendRpc() = default;
+
+    /// Invoke `method` with `params` and return the response object, which
+    /// holds either a `result` or an `error`. Throws if the node could not be
+    /// reached.
+    virtual nlohmann::json request(std::string_view method, const nlohmann::json& params = nlohmann::json::object()) = 0;
+};
+
+/// Requests sent over HTTP to the `/json_rpc` endpoint of the oxend RPC
+/// server at `url`
+class HttpOxendRpc final : public OxendRpc {
+public:
+    explicit HttpOxendRpc(std::string url, std::chrono::milliseconds _timeout = std::chrono::seconds(20));
+
+    nlohmann::json request(std::string_view method, const nlohmann::json& params = nlohmann::json::object()) override;
+
+    std::string               url;
+    std::chrono::milliseconds timeout;
+};
+
+/// In-process stand-in for oxend that answers the liquidation requests for
+/// the nodes of a `ServiceNodeList` in the same format as oxend, so the
+/// liquidator can be run without an oxen network. The nodes in
+/// `liquidationHeights` are treated as deregistered, they are reported as
+/// non-signers and every other node in the list signs the liquidations.
+///
+/// Supports `get_height`, `bls_exit_liquidation_list` and
+/// `bls_exit_liquidation_request`, a node's oxend pubkey is its service node
+/// ID as a 32 byte big-endian hex string (see `serviceNodePubkey`).
+class MockOxend final : public OxendRpc {
+public:
+    /// `snl` must outlive the mock, liquidations are signed for the rewards
+    /// contract at `contractAddress` on `chainID`.
+    MockOxend(ServiceNodeList& _snl, uint32_t _chainID, std::string _contractAddress);
+
+    nlohmann::json request(std::string_view method, const nlohmann::json& params = nlohmann::json::object()) override;
+
+    static std::string serviceNodePubkey(uint64_t serviceNodeID);
+
+    // NOTE: Must be modified whilst no requests are being made
+    uint64_t                                             height = 0;
+    std::map<uint64_t, uint64_t>                         liquidationHeights; // NOTE: Service node ID to the height it is liquidatable from
+    std::optional<std::chrono::system_clock::time_point> timestamp;          // NOTE: Timestamp to sign liquidations with, defaults to now
+
+private:
+    ServiceNodeList& snl;
+    uint32_t         chainID;
+    std::string      contractAddress;
+    std::mutex       mutex;
+};
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "service_node_rewards/multicall.hpp"
+#include "service_node_rewards/service_node_list.hpp"
+#include "service_node_rewards/service_node_rewards_contract.hpp"
+#include "service_node_rewards/uint256.hpp"
+#include "ethyl/transaction.hpp"
+
+/// Local ledger of the rewards accrued by each recipient that settles them
+/// with the rewards contract in bulk.
+///
+/// `prepare` reads the recipients' current rewards from the contract in
+/// `aggregate3` calls of `readChunkSize` recipients, compares them with the
+/// accrued rewards and signs an `updateRewardsBalance` for every recipient
+/// that is owed more across the service node list's `signingPool`. The
+/// transactions are returned ready to be sent, e.g. through a
+/// `TransactionPipeline`.
+///
+/// ```
+/// RewardsLedger ledger{snl, rewards_contract, config.CHAIN_ID};
+/// ledger.accrue(address, amount);
+/// ...
+/// RewardsLedger::Batch batch = ledger.prepare(multicall, signers);
+/// for (const RewardsLedger::Update& update : batch.updates)
+///     pipeline.submit(update.tx);
+/// ```
+class RewardsLedger {
+public:
+    struct Update {
+        std::string        address;        // NOTE: 0x prefixed, lower-case
+        Uint256            onChainRewards; // NOTE: The recipient's `rewards` in the contract
+        Uint256            accruedRewards;
+        ethyl::Transaction tx{"", 0, 0};
+
+        Uint256 delta() const { return accruedRewards - onChainRewards; }
+    };
+
+    struct Batch {
+        std::vector<Update>      updates;
+        std::vector<std::string> behind; // NOTE: The contract holds more than was accrued, it rejects decreases
+        size_t                   unchanged = 0;
+        std::chrono::nanoseconds readDuration{0};
+        std::chrono::nanoseconds signDuration{0};
+
+        size_t recipients() const { return updates.size() + behind.size() + unchanged; }
+
+        /// Recipients read and settled per second of `readDuration` and
+        /// `signDuration`
+        double recipientsPerSecond() const;
+    };
+
+    /// `snl` and `contract` must outlive the ledger, the updates are signed
+    /// for `contract` on `chainID`.
+    RewardsLedger(ServiceNodeList& _snl, ServiceNodeRewardsContract& _contract, uint32_t _chainID);
+
+    /// Add `amount` to the rewards accrued by `address` (hex with or without a
+    /// 0x prefix)
+    void accrue(std::string_view address, const Uint256& amount);
+
+    /// Rewards accrued by `address`, 0 if it has accrued nothing
+    Uint256 accrued(std::string_view address) const;
+
+    /// Read the contract's rewards of every recipient in the ledger through
+    /// `multicall` (which must have no calls queued) and sign the updates of
+    /// the recipients that are owed more with `signers`, the IDs of the nodes
+    /// that sign. In `AggregateSecretKey` mode the updates are signed in
+    /// parallel on `snl`'s `signingPool`, in the other modes each signature is
+    /// parallelised by `snl` instead and the updates are signed in turn.
+    Batch prepare(Multicall3& multicall, std::span<const uint64_t> signers);
+
+    /// Number of recipients read per `aggregate3` call
+    size_t readChunkSize = 500;
+
+    /// Accrued rewards keyed by the recipient's address in lower-case hex
+    /// without a 0x prefix
+    std::map<std::string, Uint256> balances;
+
+private:
+    ServiceNodeList&            snl;
+    ServiceNodeRewardsContract& contract;
+    uint32_t                    chainID;
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "ethyl/provider.hpp"
+
+/// The reads the contract classes make against the blockchain. The contracts
+/// read through this interface instead of `ethyl::Provider` directly so that
+/// tests can substitute a provider that doesn't need a running node, e.g.
+/// `ReplayRpcProvider`.
+class RpcProvider {
+public:
+    virtual ~RpcProvider() = default;
+
+    /// `eth_call` the contract at `address` with the hex encoded call `data`
+    /// against the latest block and return the hex encoded return value.
+    /// Throws if the call fails or reverts.
+    virtual std::string ethCall(std::string_view address, std::string_view data) = 0;
+};
+
+/// Reads from a node through an `ethyl::Provider`, the default provider of
+/// the contract classes.
+class EthylRpcProvider final : public RpcProvider {
+public:
+    explicit EthylRpcProvider(std::shared_ptr<ethyl::Provider> _provider) : provider(std::move(_provider)) {}
+
+    std::string ethCall(std::string_view address, std::string_view data) override;
+
+    std::shared_ptr<ethyl::Provider> provider;
+};
+
+/// Records the responses of the calls made through `upstream` or replays
+/// previously recorded responses without a node.
+///
+/// Responses are stored per (address, call data) in the order they were made
+/// and replayed in the same order, so a read of state that was modified in
+/// between two calls replays both values. A replayed run must make the same
+/// calls as the recorded run, a call without a remaining recorded response
+/// throws.
+///
+/// ```
+/// // Record against a node
+/// auto recorder = std::make_shared<ReplayRpcProvider>(contract.rpc);
+/// contract.rpc  = recorder;
+/// ...
+/// recorder->save("responses.json");
+///
+/// // Replay offline
+/// contract.rpc = std::make_shared<ReplayRpcProvider>(ReplayRpcProvider::load("responses.json"));
+/// ```
+class ReplayRpcProvider final : public RpcProvider {
+public:
+    /// Record the responses of `upstream`, if `upstream` is empty the
+    /// provider only replays the responses it has been given.
+    explicit ReplayRpcProvider(std::shared_ptr<RpcProvider> _upstream = nullptr) : upstream(std::move(_upstream)) {}
+
+    /// Load responses written by `save` to replay. Throws if the file can't
+    /// be read or isn't a recording.
+    static ReplayRpcProvider load(const std::filesystem::path& path);
+
+    /// Write every response recorded or loaded as JSON to `path`
+    void save(const std::filesystem::path& path) const;
+
+    /// Store `result` as the next response of `data` called on `address`
+    void add(std::string_view address, std::string_view data, std::string result);
+
+    std::string ethCall(std::string_view address, std::string_view data) override;
+
+    std::shared_ptr<RpcProvider> upstream;
+
+private:
+    struct Responses {
+        std::vector<std::string> results;
+        size_t                   next = 0; // NOTE: Index of the next result to replay
+    };
+
+    /// Keyed by the lower-cased address and call data
+    std::map<std::pair<std::string, std::string>, Responses> responses;
+};
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+/// Constant-evaluable keccak256 (the original Keccak padding used by Ethereum,
+/// not SHA3) for hashing short strings at compile time, e.g. function
+/// signatures into selectors. This is a straightforward implementation of
+/// Keccak-f[1600], for hashing at runtime prefer the optimised `keccak` in
+/// crypto/keccak.h.
+namespace constexpr_keccak {
+    inline constexpr std::array<uint64_t, 24> ROUND_CONSTANTS = {
+        0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
+        0x000000000000808bULL, 0x0000000080000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
+        0x000000000000008aULL, 0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+        0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
+        0x8000000000008002ULL, 0x8000000000000080ULL, 0x000000000000800aULL, 0x800000008000000aULL,
+        0x8000000080008081ULL, 0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL,
+    };
+
+    inline constexpr std::array<int, 24> ROTATIONS = {1, 3, 6, 10, 15, 21, 28, 36, 45, 55, 2, 14, 27, 41, 56, 8, 25, 43, 62, 18, 39, 61, 20, 44};
+    inline constexpr std::array<int, 24> PI_LANES  = {10, 7, 11, 17, 18, 3, 5, 16, 8, 21, 24, 4, 15, 23, 19, 13, 12, 2, 20, 14, 22, 9, 6, 1};
+
+    constexpr uint64_t rotl(uint64_t value, int shift) {
+        return (value << shift) | (value >> (64 - shift));
+    }
+
+    constexpr void keccakf(std::array<uint64_t, 25>& state) {
+        for (uint64_t roundConstant : ROUND_CONSTANTS) {
+            // NOTE: Theta
+            std::array<uint64_t, 5> column = {};
+            for (size_t x = 0; x < 5; x++)
+                column[x] = state[x] ^ state[x + 5] ^ state[x + 10] ^ state[x + 15] ^ state[x + 20];
+            for (size_t x = 0; x < 5; x++) {
+                uint64_t t = column[(x + 4) % 5] ^ rotl(column[(x + 1) % 5], 1);
+                for (size_t y = 0; y < 25; y += 5)
+                    state[y + x] ^= t;
+            }
+
+            // NOTE: Rho and pi
+            uint64_t carry = state[1];
+            for (size_t i = 0; i < 24; i++) {
+                size_t   lane = static_cast<size_t>(PI_LANES[i]);
+                uint64_t t    = state[lane];
+                state[lane]   = rotl(carry, ROTATIONS[i]);
+                carry         = t;
+            }
+
+            // NOTE: Chi
+            for (size_t y = 0; y < 25; y += 5) {
+                std::array<uint64_t, 5> row = {state[y], state[y + 1], state[y + 2], state[y + 3], state[y + 4]};
+                for (size_t x = 0; x < 5; x++)
+                    state[y + x] = row[x] ^ (~row[(x + 1) % 5] & row[(x + 2) % 5]);
+            }
+
+            // NOTE: Iota
+            state[0] ^= roundConstant;
+        }
+    }
+
+    constexpr std::array<uint8_t, 32> keccak256(std::string_view input) {
+        const size_t RATE = 136;
+
+        std::array<uint64_t, 25> state = {};
+        std::array<uint8_t, RATE> block = {};
+        size_t offset = 0;
+        for (;;) {
+            size_t size = input.size() - offset < RATE ? input.size() - offset : RATE;
+            block       = {};
+            for (size_t i = 0; i < size; i++)
+                block[i] = static_cast<uint8_t>(input[offset + i]);
+            offset += size;
+
+            bool last = size < RATE;
+            if (last) {
+                block[size] ^= 0x01;
+                block[RATE - 1] ^= 0x80;
+            }
+
+            for (size_t lane = 0; lane < RATE / 8; lane++) {
+                uint64_t word = 0;
+                for (size_t byte = 0; byte < 8; byte++)
+                    word |= static_cast<uint64_t>(block[lane * 8 + byte]) << (byte * 8);
+                state[lane] ^= word;
+            }
+            keccakf(state);
+
+            if (last)
+                break;
+        }
+
+        std::array<uint8_t, 32> result = {};
+        for (size_t i = 0; i < result.size(); i++)
+            result[i] = static_cast<uint8_t>(state[i / 8] >> ((i % 8) * 8));
+        return result;
+    }
+}
+
+/// 4 byte function selector as 0x prefixed hex, computed at compile time from
+/// the canonical Solidity function signature, e.g.
+///
+///   static constexpr FunctionSelector TRANSFER{"transfer(address,uint256)"};
+///   AbiEncoder abi{TRANSFER, 2};
+///
+/// This is the compile time equivalent of `ethyl::utils::toEthFunctionSignature`.
+struct FunctionSelector {
+    std::array<char, 2 + 4 * 2> hex = {};
+
+    consteval explicit FunctionSelector(std::string_view signature) {
+        constexpr char HEX_DIGITS[] = "0123456789abcdef";
+        std::array<uint8_t, 32> hash = constexpr_keccak::keccak256(signature);
+        hex[0] = '0';
+        hex[1] = 'x';
+        for (size_t i = 0; i < 4; i++) {
+            hex[2 + i * 2]     = HEX_DIGITS[hash[i] >> 4];
+            hex[2 + i * 2 + 1] = HEX_DIGITS[hash[i] & 0xf];
+        }
+    }
+
+    constexpr std::string_view view() const { return {hex.data(), hex.size()}; }
+    constexpr operator std::string_view() const { return view(); }
+};
+
+/// 32 byte event topic (the keccak256 of the canonical event signature) as 0x
+/// prefixed hex, computed at compile time. This is `topics[0]` of the logs
+/// returned by `eth_getLogs` for non-anonymous events, e.g.
+///
+///   static constexpr EventTopic REWARDS_CLAIMED{"RewardsClaimed(address,uint256)"};
+struct EventTopic {
+    std::array<char, 2 + 32 * 2> hex = {};
+
+    consteval explicit EventTopic(std::string_view signature) {
+        constexpr char HEX_DIGITS[] = "0123456789abcdef";
+        std::array<uint8_t, 32> hash = constexpr_keccak::keccak256(signature);
+        hex[0] = '0';
+        hex[1] = 'x';
+        for (size_t i = 0; i < hash.size(); i++) {
+            hex[2 + i * 2]     = HEX_DIGITS[hash[i] >> 4];
+            hex[2 + i * 2 + 1] = HEX_DIGITS[hash[i] & 0xf];
+        }
+    }
+
+    constexpr std::string_view view() const { return {hex.data(), hex.size()}; }
+    constexpr operator std::string_view() const { return view(); }
+};
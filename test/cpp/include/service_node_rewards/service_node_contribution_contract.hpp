@@ -0,0 +1,122 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "service_node_rewards/multicall.hpp"
+#include "service_node_rewards/rpc_provider.hpp"
+#include "service_node_rewards/selector.hpp"
+#include "service_node_rewards/service_node_rewards_contract.hpp"
+#include "service_node_rewards/uint256.hpp"
+#include "ethyl/provider.hpp"
+#include "ethyl/transaction.hpp"
+
+/// An amount reserved for an address by the operator when (re)initialising
+/// the contract, the argument of `resetUpdateAndContribute`
+struct ReservedContributor {
+    std::string address;
+    Uint256     amount;
+};
+
+/// An entry of the return value of `getReserved`
+struct ReservedContribution {
+    std::array<unsigned char, 20> address;
+    Uint256                       amount;
+    bool                          received; // NOTE: The reserved address has contributed
+};
+
+/// The return value of `serviceNodeParams`
+struct ServiceNodeParams {
+    std::array<unsigned char, 32> ed25519Pubkey;
+    std::array<unsigned char, 64> ed25519Signature;
+    uint16_t                      fee;
+};
+
+/// Binding of a `ServiceNodeContribution` contract, a multi-contributor
+/// stake that registers the node with the rewards contract once it has been
+/// fully funded and finalized.
+///
+/// The list views (`getContributions`, `getReserved`) return every entry in
+/// one call and are decoded in one pass. The call data and decode functions
+/// are exposed so the views of many contribution contracts can be read in a
+/// single `Multicall3` call, see `getContributions(Multicall3&, ...)`.
+class ServiceNodeContributionContract {
+public:
+    /// `status()` of the contract, `IServiceNodeContribution.Status`
+    enum class Status : uint8_t {
+        WaitForOperatorContrib,
+        OpenForPublicContrib,
+        WaitForFinalized,
+        Finalized,
+    };
+
+    // NOTE: Function selectors of the contract, hashed at compile time
+    static constexpr inline FunctionSelector CONTRIBUTE_FUNDS            {"contributeFunds(uint256,address)"};
+    static constexpr inline FunctionSelector FINALIZE                    {"finalize()"};
+    static constexpr inline FunctionSelector RESET                       {"reset()"};
+    static constexpr inline FunctionSelector WITHDRAW_CONTRIBUTION       {"withdrawContribution()"};
+    static constexpr inline FunctionSelector RESET_UPDATE_AND_CONTRIBUTE {"resetUpdateAndContribute((uint256,uint256),(uint256,uint256,uint256,uint256),(uint256,uint256,uint256,uint16),(address,uint256)[],bool,address,uint256)"};
+    static constexpr inline FunctionSelector GET_CONTRIBUTIONS           {"getContributions()"};
+    static constexpr inline FunctionSelector GET_RESERVED                {"getReserved()"};
+    static constexpr inline FunctionSelector BLS_SIGNATURE               {"blsSignature()"};
+    static constexpr inline FunctionSelector SERVICE_NODE_PARAMS         {"serviceNodeParams()"};
+    static constexpr inline FunctionSelector STATUS                      {"status()"};
+
+    ethyl::Transaction contributeFunds(const Uint256& amount, const std::string& beneficiary);
+    ethyl::Transaction finalize();
+    ethyl::Transaction reset();
+    ethyl::Transaction withdrawContribution();
+
+    /// Reset the contract, replace the node's keys, fee and reserved
+    /// contributors and contribute `amount` on behalf of the operator. The
+    /// keys are given in the same format as `ServiceNodeRewardsContract::addBLSPublicKey`.
+    ethyl::Transaction resetUpdateAndContribute(const std::string& publicKey,
+                                                const std::string& sig,
+                                                const std::string& serviceNodePubkey,
+                                                const std::string& serviceNodeSignature,
+                                                uint16_t fee,
+                                                std::span<const ReservedContributor> reserved,
+                                                bool manualFinalize,
+                                                const std::string& beneficiary,
+                                                const Uint256& amount);
+
+    /// Every contributor in the order they contributed, the operator first
+    std::vector<Contributor>          getContributions();
+    std::vector<ReservedContribution> getReserved();
+
+    /// The BLS proof of possession the node will be registered with as hex,
+    /// the same format as `utils::SignatureToHex`
+    std::string       blsSignature();
+    ServiceNodeParams serviceNodeParams();
+    Status            status();
+
+    /// Retrieve `getContributions` of every contract in `contractAddresses`
+    /// in one `aggregate3` call through `multicall` (which must have no calls
+    /// queued), returned in the same order as `contractAddresses`.
+    std::vector<std::vector<Contributor>> getContributions(Multicall3& multicall, std::span<const std::string> contractAddresses);
+
+    // NOTE: Decode the ABI encoded return values of the views
+    static std::vector<Contributor>          decodeContributions(std::string_view callResultHex);
+    static std::vector<ReservedContribution> decodeReserved(std::string_view callResultHex);
+    static ServiceNodeParams                 decodeServiceNodeParams(std::string_view callResultHex);
+
+    /// Address of the contribution contract, typically deployed per node by
+    /// the `ServiceNodeContributionFactory`
+    std::string contractAddress;
+
+    /// Provider must be set with an RPC client configure to allow the contract
+    /// to communicate with the blockchain. If the provider is not setup, the
+    /// functions that require a provider will throw.
+    std::shared_ptr<ethyl::Provider> client_ptr{ethyl::Provider::make_provider()};
+    ethyl::Provider& provider{*client_ptr};
+
+    /// Provider the contract's reads are made through, by default `provider`.
+    /// Replace it to read from another source, e.g. a `ReplayRpcProvider` to
+    /// serve recorded responses without a node.
+    std::shared_ptr<RpcProvider> rpc{std::make_shared<EthylRpcProvider>(client_ptr)};
+};
@@ -14,43 +14,256 @@
 #undef MCLBN_NO_AUTOLINK
 #pragma GCC diagnostic pop
 
+#include "service_node_rewards/uint256.hpp"
+#include "service_node_rewards/worker_pool.hpp"
+
+#include <array>
 #include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <vector>
 #include <span>
+#include <unordered_map>
 
 constexpr inline uint64_t SERVICE_NODE_LIST_SENTINEL = 0;
 
+/// Doubly-linked list links of a service node, mirrors the `next`/`prev` of
+/// the rewards contract's `_serviceNodes` linked list.
+struct ServiceNodeLinks {
+    uint64_t next = SERVICE_NODE_LIST_SENTINEL;
+    uint64_t prev = SERVICE_NODE_LIST_SENTINEL;
+};
+
+/// Dense bitset keyed by service node ID, used to mark the signers of an
+/// aggregate signature.
+class SignerSet {
+public:
+    SignerSet() = default;
+    explicit SignerSet(std::span<const uint64_t> serviceNodeIDs);
+
+    void insert(uint64_t serviceNodeID);
+    bool contains(uint64_t serviceNodeID) const;
+
+private:
+    std::vector<uint64_t> words;
+};
+
+/// The domain separation tags the rewards contract derives in `buildTag` for a
+/// specific chain and contract. Every signed message is prefixed with (and
+/// hashed to G2 with) one of these tags. Deriving each tag costs a keccak so
+/// they are derived once and passed into the signing functions.
+struct DomainTags {
+    std::array<uint8_t, 32> proofOfPossession;
+    std::array<uint8_t, 32> reward;
+    std::array<uint8_t, 32> exit;
+    std::array<uint8_t, 32> liquidate;
+    std::array<uint8_t, 32> hashToG2;
+
+    DomainTags(uint32_t chainID, std::string_view contractAddress);
+};
+
+/// Fixed capacity buffer that the messages signed by the service nodes are
+/// serialised into. Fields are written as raw bytes with the same layout as
+/// `abi.encodePacked` in the rewards contract so no hex round-trip or heap
+/// allocation is necessary to produce the bytes to sign. Appending past the
+/// capacity throws.
+class MessageBuilder {
+public:
+    /// Large enough for the biggest signed message, the proof of possession
+    /// (tag 32 + BLS pubkey 64 + address 20 + ed25519 pubkey 32 bytes).
+    static constexpr size_t CAPACITY = 160;
+
+    MessageBuilder& append(std::span<const uint8_t> data);
+
+    /// Left pad `data` with zeros to `width` bytes, throws if `data` is
+    /// larger than `width`.
+    MessageBuilder& appendLeftPadded(std::span<const uint8_t> data, size_t width);
+
+    /// Append a 20 byte Ethereum address given in hex with or without a 0x
+    /// prefix. Shorter addresses are left padded with zeros.
+    MessageBuilder& appendAddress(std::string_view hex);
+
+    /// Append `value` as a big-endian Solidity `uint256`
+    MessageBuilder& appendU256(const Uint256& value);
+
+    std::span<const uint8_t> bytes() const { return {buffer.data(), size}; }
+
+private:
+    uint8_t* reserve(size_t count);
+
+    std::array<uint8_t, CAPACITY> buffer;
+    size_t                        size = 0;
+};
+
+/// Precomputed multiples of a fixed point (`base`) for multiplying it by many
+/// scalars. The scalar is split into windows of `windowBits` bits and the
+/// table stores `d * 2^(windowBits * i) * base` for every window `i` and digit
+/// `d`, so a multiplication is one table lookup and addition per window with
+/// no doublings.
+///
+/// Building the table costs `windows * (2^windowBits - 1)` additions, see
+/// `optimalWindowBits` to size it for the number of multiplications.
+///
+/// NOTE: The lookups are indexed by the scalar's digits so `mul` is *not*
+/// constant time unlike `mulCT`. This is acceptable for the test keys of this
+/// service node list only.
+template <typename Point>
+class FixedBaseTable {
+public:
+    static constexpr size_t MIN_WINDOW_BITS = 2;
+    static constexpr size_t MAX_WINDOW_BITS = 8;
+
+    /// Throws if `_windowBits` is outside of [MIN_WINDOW_BITS, MAX_WINDOW_BITS]
+    FixedBaseTable(const Point& base, size_t _windowBits);
+
+    /// `base * scalar`, equal to `Point::mulCT(result, base, scalar)`
+    Point mul(const mcl::bn::Fr& scalar) const;
+
+    size_t windowBits() const { return bits; }
+
+    /// Window size that minimises the cost of building the table plus
+    /// `multiplications` lookups, measured in point additions
+    static size_t optimalWindowBits(size_t multiplications);
+
+private:
+    size_t             bits;
+    size_t             windows;
+    std::vector<Point> points; // NOTE: `windows` rows of 2^bits - 1 normalised points, digit 0 is omitted
+};
+
+using G1FixedBaseTable = FixedBaseTable<mcl::bn::G1>;
+using G2FixedBaseTable = FixedBaseTable<mcl::bn::G2>;
+
+/// A message mapped onto G2 and multiplied by the cofactor (`Hm`) so that it
+/// can be signed by many nodes whilst only paying for the hash-to-curve once.
+struct PreparedMessage {
+    mcl::bn::G2 Hm;
+
+    /// Optional multiples of `Hm`, when set `ServiceNode::signPrepared` signs
+    /// with a table lookup instead of a generic scalar multiplication.
+    std::shared_ptr<const G2FixedBaseTable> table;
+
+    static PreparedMessage prepare(std::span<const uint8_t> msg, const DomainTags& tags);
+    static PreparedMessage prepare(std::span<const uint8_t> msg, uint32_t chainID, std::string_view contractAddress);
+
+    /// Build `table` sized for signing the message `signers` times
+    PreparedMessage& precompute(size_t signers);
+};
+
 class ServiceNode {
 private:
     bls::SecretKey secretKey;
+    bls::PublicKey publicKey; // NOTE: Derived from `secretKey` on construction
 public:
     uint64_t service_node_id = SERVICE_NODE_LIST_SENTINEL;
-    ServiceNode() = default;
+    ServiceNode();
     ServiceNode(uint64_t _service_node_id);
+
+    /// Derive the public key with `generatorTable`, a table of the generator
+    /// set by `ServiceNodeList`, instead of `bls::SecretKey::getPublicKey`
+    ServiceNode(uint64_t _service_node_id, const G1FixedBaseTable& generatorTable);
+    bls::Signature blsSignHash(std::span<const uint8_t> bytes, const DomainTags& tags) const;
     bls::Signature blsSignHash(std::span<const uint8_t> bytes, uint32_t chainID, std::string_view contractAddress) const;
+    bls::Signature signPrepared(const PreparedMessage& message) const;
+    mcl::bn::Fr    getSecretScalar() const;
+    std::string    proofOfPossession(const DomainTags& tags, const std::string& senderEthAddress, const std::string& serviceNodePubkey);
     std::string    proofOfPossession(uint32_t chainID, const std::string& contractAddress, const std::string& senderEthAddress, const std::string& serviceNodePubkey);
-    std::string    getPublicKeyHex() const;
-    bls::PublicKey getPublicKey() const;
+    std::string           getPublicKeyHex() const;
+    const bls::PublicKey& getPublicKey() const;
 };
 
 class ServiceNodeList {
 public:
+    enum class SigningMode {
+        /// Sum the signers' secret keys in Fr and multiply `Hm` by the sum
+        /// once, `Hm * (sk_0 + ... + sk_n)`. Equal to aggregating each node's
+        /// signature but costs a single G2 multiplication.
+        AggregateSecretKey,
+        /// Every signer signs `Hm` and the signatures are added together.
+        PerNode,
+        /// Sign with both of the above and throw if the signatures differ.
+        CrossCheck,
+    };
+
+    /// Storage for the nodes, deleting a node swaps the last node into its
+    /// slot so this is *not* in the order of the contract's linked list. Use
+    /// `links` (or `nextServiceNodeID`/`prevServiceNodeID`) to walk the nodes
+    /// in list order.
     std::vector<ServiceNode> nodes;
     uint64_t                 next_service_node_id = SERVICE_NODE_LIST_SENTINEL + 1;
 
-    ServiceNodeList(size_t numNodes);
+    /// Service node ID to the index of the node in `nodes`
+    std::unordered_map<uint64_t, size_t> nodeIndices;
+
+    /// Service node ID to its linked list links, the sentinel is stored at
+    /// `SERVICE_NODE_LIST_SENTINEL`. New nodes are appended to the tail of the
+    /// list identically to the contract.
+    std::unordered_map<uint64_t, ServiceNodeLinks> links;
+
+    /// Number of workers `workerPool` creates the `signingPool` with, 0 uses
+    /// the number of hardware threads and 1 signs serially without a pool.
+    size_t signingThreads;
+
+    /// Pool used by `PerNode` signing to sign and aggregate signatures across
+    /// the nodes in parallel. Each worker signs a contiguous shard of the
+    /// signers and the partial aggregates are combined as a tree, the
+    /// resulting signature is identical to signing serially.
+    ///
+    /// This is created by `workerPool` on first use, e.g. the first `PerNode`
+    /// aggregation, so lists that never sign in parallel never spawn threads.
+    /// Callers may assign a pool shared between lists instead, nullptr signs
+    /// serially on the calling thread when `signingThreads` is 1.
+    std::shared_ptr<WorkerPool> signingPool;
+
+    SigningMode signingMode = SigningMode::AggregateSecretKey;
+
+    /// `PerNode` signing precomputes a table of the message's `Hm` when there
+    /// are at least this many signers, SIZE_MAX always uses `G2::mulCT`.
+    size_t precomputeMinSigners = 16;
+
+    /// Optional table of the G1 generator, new nodes derive their public key
+    /// with it when set. The constructor builds it when creating at least
+    /// `GENERATOR_TABLE_MIN_NODES` nodes, reset it to derive with
+    /// `bls::SecretKey::getPublicKey`.
+    static constexpr size_t                 GENERATOR_TABLE_MIN_NODES = 16;
+    std::shared_ptr<const G1FixedBaseTable> generatorTable;
+
+    /// Sum of the public keys of every node in `nodes`. This is updated
+    /// incrementally by `addNode` and `deleteNode` in the same manner as the
+    /// rewards contract maintains its `_aggregatePubkey`.
+    bls::PublicKey aggregatePubkey;
+
+    /// Create `numNodes` service nodes. `signingThreads` configures the number
+    /// of workers in the `signingPool`, 0 uses the number of hardware threads.
+    /// The pool is not created until it is first needed.
+    ServiceNodeList(size_t numNodes, size_t signingThreads = 0);
     ~ServiceNodeList();
 
+    /// Get the `signingPool`, creating it with `signingThreads` workers if it
+    /// is unset. Returns nullptr when signing serially (`signingThreads` is 1
+    /// and no pool was assigned).
+    std::shared_ptr<WorkerPool> workerPool();
+
     void addNode();
     void deleteNode(uint64_t serviceNodeID);
     std::string getLatestNodePubkey();
 
     std::string aggregatePubkeyHex();
+    std::string aggregateSignatures(const std::string& message, const DomainTags& tags);
     std::string aggregateSignatures(const std::string& message, uint32_t chainID, std::string_view contractAddress);
+    std::string aggregateSignaturesFromIndices(const std::string& message, const std::vector<int64_t>& indices, const DomainTags& tags);
     std::string aggregateSignaturesFromIndices(const std::string& message, const std::vector<int64_t>& indices, uint32_t chainID, std::string_view contractAddress);
 
+    std::tuple<std::string, uint64_t, std::string> liquidateNodeFromIndices(
+            uint64_t nodeID,
+            const DomainTags& tags,
+            const std::vector<uint64_t>& indices,
+            std::optional<std::chrono::system_clock::time_point> timestamp = std::nullopt) {
+        return exitNodeFromIndices(nodeID, tags, indices, timestamp, true);
+    }
     std::tuple<std::string, uint64_t, std::string> liquidateNodeFromIndices(
             uint64_t nodeID,
             uint32_t chainID,
@@ -59,6 +272,12 @@ public:
             std::optional<std::chrono::system_clock::time_point> timestamp = std::nullopt) {
         return exitNodeFromIndices(nodeID, chainID, contractAddress, indices, timestamp, true);
     }
+    std::tuple<std::string, uint64_t, std::string> exitNodeFromIndices(
+            uint64_t nodeID,
+            const DomainTags& tags,
+            const std::vector<uint64_t>& indices,
+            std::optional<std::chrono::system_clock::time_point> timestamp = std::nullopt,
+            bool liquidate = false);
     std::tuple<std::string, uint64_t, std::string> exitNodeFromIndices(
             uint64_t nodeID,
             uint32_t chainID,
@@ -66,12 +285,45 @@ public:
             const std::vector<uint64_t>& indices,
             std::optional<std::chrono::system_clock::time_point> timestamp = std::nullopt,
             bool liquidate = false);
-    std::string updateRewardsBalance(const std::string& address, uint64_t amount, uint32_t chainID, const std::string& contractAddress, const std::vector<uint64_t>& service_node_ids);
 
-    std::vector<uint64_t> findNonSigners(const std::vector<uint64_t>& indices);
+    /// The `DomainTags` overloads of `exitNodeFromIndices` and
+    /// `updateRewardsBalance` only read the list, so they may be called from
+    /// several threads at once (e.g. `RewardsLedger::prepare`) as long as no
+    /// thread modifies the list meanwhile: adding or deleting nodes, or
+    /// changing `signingMode`, `precomputeMinSigners` or `signingPool`. The
+    /// chain ID overloads populate the domain tag cache and must not be called
+    /// concurrently. In `PerNode` and `CrossCheck` mode each call waits on
+    /// `signingPool`, so they must not be called from one of its tasks.
+    std::string updateRewardsBalance(const std::string& address, const Uint256& amount, const DomainTags& tags, const std::vector<uint64_t>& service_node_ids);
+    std::string updateRewardsBalance(const std::string& address, const Uint256& amount, uint32_t chainID, const std::string& contractAddress, const std::vector<uint64_t>& service_node_ids);
+
+    /// Get the domain tags for the chain and contract, the tags are derived on
+    /// first use and cached for subsequent calls.
+    const DomainTags& domainTags(uint32_t chainID, std::string_view contractAddress);
+
+    /// Get the IDs of the nodes that are not in `signers` in ascending order
+    /// (the order of the linked list). This is the list of non-signers
+    /// expected by the contract's signature verified functions.
+    std::vector<uint64_t> findNonSigners(const SignerSet& signers) const;
+    std::vector<uint64_t> findNonSigners(const std::vector<uint64_t>& indices) const;
     std::vector<uint64_t> randomSigners(const size_t numOfRandomIndices);
-    int64_t findNodeIndex(uint64_t service_node_id);
+    int64_t findNodeIndex(uint64_t service_node_id) const;
     uint64_t randomServiceNodeID();
 
+    uint64_t nextServiceNodeID(uint64_t service_node_id) const;
+    uint64_t prevServiceNodeID(uint64_t service_node_id) const;
+
+private:
+    std::map<std::pair<uint32_t, std::string>, DomainTags> domainTagCache;
+    std::mutex                                             signingPoolMutex;
+
+    /// Get the index of the node in `nodes`, throws `std::invalid_argument` if
+    /// the ID is unknown or was deleted.
+    size_t nodeIndex(uint64_t service_node_id) const;
+
+    bls::Signature aggregateSign(const PreparedMessage& message, std::span<const size_t> nodeIndices);
+    bls::Signature aggregateSignPerNode(const PreparedMessage& message, std::span<const size_t> nodeIndices);
+    bls::Signature aggregateSignSummedKey(const PreparedMessage& message, std::span<const size_t> nodeIndices);
+
 // End Service Node List
 };
@@ -1,25 +1,32 @@
 #pragma once
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 #include <memory>
+#include <span>
 
 #include "service_node_rewards/ec_utils.hpp"
+#include "service_node_rewards/json_rpc_batch.hpp"
+#include "service_node_rewards/rpc_provider.hpp"
+#include "service_node_rewards/multicall.hpp"
+#include "service_node_rewards/selector.hpp"
+#include "service_node_rewards/uint256.hpp"
 #include "ethyl/provider.hpp"
 #include "ethyl/transaction.hpp"
 
 struct Recipient {
-    uint64_t rewards;
-    uint64_t claimed;
+    Uint256 rewards;
+    Uint256 claimed;
 
     // Constructor for easy initialization
-    Recipient(uint64_t _rewards, uint64_t _claimed) : rewards(_rewards), claimed(_claimed) {}
+    Recipient(const Uint256& _rewards, const Uint256& _claimed) : rewards(_rewards), claimed(_claimed) {}
 };
 
 struct Contributor {
     std::array<unsigned char, 20> address;
     std::array<unsigned char, 20> beneficiaryAddress;
-    uint64_t                      amount;
+    Uint256                       amount;
 };
 
 struct ContractServiceNode {
@@ -30,9 +37,30 @@ struct ContractServiceNode {
     uint64_t                      addedTimestamp;
     uint64_t                      leaveRequestTimestamp;
     uint64_t                      latestLeaveRequestTimestamp;
-    std::string                   deposit;
+    Uint256                       deposit;
     std::vector<Contributor>      contributors;
-    std::string                   ed25519Pubkey;
+    std::array<unsigned char, 32> ed25519Pubkey;
+};
+
+/// The return value of `allServiceNodeIDs`, every registered node in the
+/// order of the contract's linked list
+struct ContractServiceNodeIDs {
+    std::vector<uint64_t>       ids;
+    std::vector<bls::PublicKey> pubkeys; // NOTE: `pubkeys[i]` is the key of node `ids[i]`
+};
+
+/// The contract's service node list retrieved in a constant number of calls
+/// regardless of the number of nodes registered.
+struct ServiceNodeListSnapshot {
+    ContractServiceNodeIDs nodes;
+    bls::PublicKey         aggregatePubkey;
+
+    /// ID of the node registered with `pubkey` or 0 (the sentinel) if the key
+    /// is not registered, equivalent to the contract's `serviceNodeIDs`.
+    uint64_t findID(const bls::PublicKey& pubkey) const;
+
+    /// Serialised public keys sorted for binary search by `findID`
+    std::vector<std::pair<std::array<uint8_t, 64>, uint64_t>> idsByPubkey;
 };
 
 class ServiceNodeRewardsContract {
@@ -40,11 +68,62 @@ public:
     // TODO: Taken from scripts/deploy-local-test.js and hardcoded
     static constexpr inline uint64_t STAKING_REQUIREMENT = 120'000'000'000;
 
+    // NOTE: Function selectors of the contract, hashed at compile time
+    static constexpr inline FunctionSelector ADD_BLS_PUBLIC_KEY                     {"addBLSPublicKey((uint256,uint256),(uint256,uint256,uint256,uint256),(uint256,uint256,uint256,uint16),((address,address),uint256)[])"};
+    static constexpr inline FunctionSelector SERVICE_NODES                          {"serviceNodes(uint64)"};
+    static constexpr inline FunctionSelector SERVICE_NODE_IDS                       {"serviceNodeIDs(bytes)"};
+    static constexpr inline FunctionSelector TOTAL_NODES                            {"totalNodes()"};
+    static constexpr inline FunctionSelector MAX_PERMITTED_PUBKEY_AGGREGATIONS      {"maxPermittedPubkeyAggregations()"};
+    static constexpr inline FunctionSelector DESIGNATED_TOKEN                       {"designatedToken()"};
+    static constexpr inline FunctionSelector AGGREGATE_PUBKEY                       {"aggregatePubkey()"};
+    static constexpr inline FunctionSelector RECIPIENTS                             {"recipients(address)"};
+    static constexpr inline FunctionSelector LIQUIDATE_BLS_PUBLIC_KEY_WITH_SIGNATURE{"liquidateBLSPublicKeyWithSignature((uint256,uint256),uint256,(uint256,uint256,uint256,uint256),uint64[])"};
+    static constexpr inline FunctionSelector EXIT_BLS_PUBLIC_KEY_WITH_SIGNATURE     {"exitBLSPublicKeyWithSignature((uint256,uint256),uint256,(uint256,uint256,uint256,uint256),uint64[])"};
+    static constexpr inline FunctionSelector INITIATE_EXIT_BLS_PUBLIC_KEY           {"initiateExitBLSPublicKey(uint64)"};
+    static constexpr inline FunctionSelector EXIT_BLS_PUBLIC_KEY_AFTER_WAIT_TIME    {"exitBLSPublicKeyAfterWaitTime(uint64)"};
+    static constexpr inline FunctionSelector UPDATE_REWARDS_BALANCE                 {"updateRewardsBalance(address,uint256,(uint256,uint256,uint256,uint256),uint64[])"};
+    static constexpr inline FunctionSelector CLAIM_REWARDS                          {"claimRewards()"};
+    static constexpr inline FunctionSelector CLAIM_REWARDS_AMOUNT                   {"claimRewards(uint256)"};
+    static constexpr inline FunctionSelector START                                  {"start()"};
+    static constexpr inline FunctionSelector ALL_SERVICE_NODE_IDS                   {"allServiceNodeIDs()"};
+    static constexpr inline FunctionSelector ED25519_TO_SERVICE_NODE_ID             {"ed25519ToServiceNodeID(uint256)"};
+
+    // NOTE: Call data of the read calls for aggregating reads through
+    // `Multicall3` or `JsonRpcBatch`
+    static std::string serviceNodesCallData(uint64_t index);
+    static std::string serviceNodeIDsCallData(const bls::PublicKey& pKey);
+    static std::string recipientsCallData(std::string_view address);
+    static std::string ed25519ToServiceNodeIDCallData(std::span<const uint8_t, 32> ed25519Pubkey);
+
     // Method for creating a transaction to add a public key
     ethyl::Transaction addBLSPublicKey(const std::string& publicKey, const std::string& sig, const std::string& serviceNodePubkey, const std::string& serviceNodeSignature, uint64_t fee);
 
     ContractServiceNode serviceNodes(uint64_t index);
+
+    /// Retrieve `serviceNodes` for every ID in `ids` through `batch` (which
+    /// must have no requests queued), returned in the same order as `ids`.
+    std::vector<ContractServiceNode> serviceNodes(JsonRpcBatch& batch, std::span<const uint64_t> ids);
+
+    /// Retrieve `serviceNodes` for every ID in `ids` in one `aggregate3` call
+    /// through `multicall` (which must have no calls queued), returned in the
+    /// same order as `ids`.
+    std::vector<ContractServiceNode> serviceNodes(Multicall3& multicall, std::span<const uint64_t> ids);
+
+    /// Decode the ABI encoded return value of `serviceNodes` in place. If
+    /// `linksOnly` is set only the linked list links are decoded (sufficient
+    /// for the sentinel node).
+    static ContractServiceNode decodeServiceNode(std::string_view callResultHex, bool linksOnly = false);
     uint64_t            serviceNodeIDs(const bls::PublicKey& pKey);
+    uint64_t            ed25519ToServiceNodeID(std::span<const uint8_t, 32> ed25519Pubkey);
+
+    /// Retrieve the ID and key of every node in one call
+    ContractServiceNodeIDs allServiceNodeIDs();
+
+    /// Decode the ABI encoded return value of `allServiceNodeIDs`
+    static ContractServiceNodeIDs decodeAllServiceNodeIDs(std::string_view callResultHex);
+
+    /// Retrieve the node list and the aggregate public key in 2 calls
+    ServiceNodeListSnapshot snapshot();
     uint64_t            totalNodes();
     uint64_t            maxPermittedPubkeyAggregations();
     std::string         designatedToken();
@@ -52,13 +131,25 @@ public:
     bls::PublicKey      aggregatePubkey();
     Recipient           viewRecipientData(const std::string& address);
 
+    /// Retrieve `viewRecipientData` for every address through `batch` (which
+    /// must have no requests queued), returned in the same order as `addresses`.
+    std::vector<Recipient> viewRecipientData(JsonRpcBatch& batch, std::span<const std::string> addresses);
+
+    /// Retrieve `viewRecipientData` for every address in one `aggregate3` call
+    /// through `multicall` (which must have no calls queued), returned in the
+    /// same order as `addresses`.
+    std::vector<Recipient> viewRecipientData(Multicall3& multicall, std::span<const std::string> addresses);
+
+    /// Decode the ABI encoded return value of `recipients`
+    static Recipient decodeRecipient(std::string_view callResultHex);
+
     ethyl::Transaction liquidateBLSPublicKeyWithSignature(const std::string& pubkey, const uint64_t timestamp, const std::string& sig, const std::vector<uint64_t>& non_signer_indices);
     ethyl::Transaction initiateExitBLSPublicKey(const uint64_t service_node_id);
     ethyl::Transaction exitBLSPublicKeyAfterWaitTime(const uint64_t service_node_id);
     ethyl::Transaction exitBLSPublicKeyWithSignature(const std::string& pubkey, const uint64_t timestamp, const std::string& sig, const std::vector<uint64_t>& non_signer_indices);
-    ethyl::Transaction updateRewardsBalance(const std::string& address, const uint64_t amount, const std::string& sig, const std::vector<uint64_t>& non_signer_indices);
+    ethyl::Transaction updateRewardsBalance(const std::string& address, const Uint256& amount, const std::string& sig, const std::vector<uint64_t>& non_signer_indices);
     ethyl::Transaction claimRewards();
-    ethyl::Transaction claimRewards(uint64_t amount);
+    ethyl::Transaction claimRewards(const Uint256& amount);
     ethyl::Transaction start();
 
     /// Address of the ERC20 contract that must be set to the address of the
@@ -72,4 +163,9 @@ public:
     /// functions that require a provider will throw.
     std::shared_ptr<ethyl::Provider> client_ptr{ethyl::Provider::make_provider()};
     ethyl::Provider& provider{*client_ptr};
+
+    /// Provider the contract's reads are made through, by default `provider`.
+    /// Replace it to read from another source, e.g. a `ReplayRpcProvider` to
+    /// serve recorded responses without a node.
+    std::shared_ptr<RpcProvider> rpc{std::make_shared<EthylRpcProvider>(client_ptr)};
 };
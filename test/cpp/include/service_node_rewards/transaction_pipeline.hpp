@@ -0,0 +1,116 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "ethyl/signer.hpp"
+#include "ethyl/transaction.hpp"
+#include "service_node_rewards/json_rpc_batch.hpp"
+
+/// Signs and submits transactions from a single account without waiting for
+/// each one to be mined before sending the next, e.g. registering thousands
+/// of BLS keys with `addBLSPublicKey` or a run of `updateRewardsBalance` and
+/// `claimRewards` calls.
+///
+/// The account's pending nonce is read from the node once and then assigned
+/// locally so that up to `maxInFlight` transactions are pending at once, the
+/// local nonce carries over between calls to `wait`. The chain ID and fees
+/// are re-read at the start of every `wait` so that a long-lived pipeline
+/// (e.g. the one driven by `Liquidator::run`) prices its transactions at the
+/// current base fee. Raw transactions are sent and their receipts polled with
+/// `JsonRpcBatch`, so each round-trip to the node covers every transaction in
+/// flight.
+///
+/// ```cpp
+/// TransactionPipeline pipeline{signer, seckey, std::string(config.RPC_URL)};
+/// for (auto& node : snl.nodes)
+///     pipeline.submit(rewards_contract.addBLSPublicKey(...));
+/// for (const TransactionPipeline::Result& result : pipeline.wait())
+///     REQUIRE(result.success);
+/// ```
+class TransactionPipeline {
+public:
+    struct Result {
+        std::string    hash;     // NOTE: 0x prefixed, empty if the node rejected the transaction
+        uint64_t       nonce = 0;
+        bool           success = false; // NOTE: Mined with a receipt status of 1
+        nlohmann::json receipt;  // NOTE: Null if the transaction was not mined
+        std::string    error;    // NOTE: Reason the transaction failed to send or was not mined in time
+
+        /// Time from sending the raw transaction to observing its receipt
+        std::chrono::steady_clock::duration latency{};
+    };
+
+    /// `signer` must outlive the pipeline, it signs the transactions with
+    /// `seckey`. The chain ID, fees and starting nonce of the account are
+    /// read from the node at `url`.
+    TransactionPipeline(ethyl::Signer& signer, std::vector<unsigned char> seckey, std::string url, size_t maxInFlight = 64);
+
+    /// Queue `tx` to be signed and sent, returns the index of its result in
+    /// the array returned by `wait`. The nonce, chain ID and fees of `tx` are
+    /// assigned by the pipeline.
+    size_t submit(ethyl::Transaction tx);
+
+    size_t size() const { return entries.size(); }
+
+    /// Send the queued transactions and wait until every one of them has been
+    /// mined or `timeout` elapses. The fees are read from the node before the
+    /// first transaction is sent. Results are returned in submission order
+    /// and the queue is cleared, the local nonce carries over to the
+    /// transactions submitted afterwards.
+    ///
+    /// Sending is not retried, if the node rejects a transaction its nonce
+    /// may be left unused which prevents the later transactions in the same
+    /// batch from being mined (they time out). The pipeline re-reads the
+    /// account's pending nonce from the node before sending anything further.
+    std::vector<Result> wait(
+            std::chrono::milliseconds timeout      = std::chrono::seconds(60),
+            std::chrono::milliseconds pollInterval = std::chrono::milliseconds(50));
+
+    std::string             senderAddress;
+    size_t                  maxInFlight;
+    JsonRpcBatch::Transport transport; // NOTE: Passed to every batch sent to the node, see `JsonRpcBatch::transport`
+
+private:
+    struct Entry {
+        ethyl::Transaction                    tx;
+        Result                                result;
+        std::chrono::steady_clock::time_point sentAt;
+    };
+
+    /// Sign and send the queued entries from `sendCursor` until `maxInFlight`
+    /// transactions are pending, appending the index of each sent entry to
+    /// `inFlight`.
+    void send(std::vector<size_t>& inFlight);
+
+    /// Read the chain ID and fees from the node into `fees`, and the account's
+    /// pending nonce into `nextNonce` if it is unset.
+    void sync();
+
+    /// Retrieve the receipts of the `inFlight` entries, removing the ones that
+    /// were mined. Returns the number of entries removed.
+    size_t poll(std::vector<size_t>& inFlight);
+
+    ethyl::Signer&             signer;
+    std::vector<unsigned char> seckey;
+    std::string                url;
+    std::vector<Entry>         entries;
+    size_t                     sendCursor = 0;
+
+    struct Fees {
+        uint64_t chainId              = 0;
+        uint64_t maxPriorityFeePerGas = 0;
+        uint64_t maxFeePerGas         = 0;
+    };
+
+    // NOTE: `fees` is reset by every `wait`, `nextNonce` is kept until the
+    // node rejects a transaction
+    std::optional<Fees>     fees;
+    std::optional<uint64_t> nextNonce;
+};
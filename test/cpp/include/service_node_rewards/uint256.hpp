@@ -0,0 +1,134 @@
+#pragma once
+
+#include <array>
+#include <compare>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+
+/// Fixed width unsigned 256 bit integer, the value of a Solidity `uint256`
+/// such as a token amount. The value is stored inline as four 64 bit limbs
+/// so parsing, conversion and arithmetic never allocate and the type can be
+/// copied as is into the binary records of a `ContractStateFile`.
+///
+/// Arithmetic wraps modulo 2^256 like the built-in unsigned integers, compare
+/// before subtracting where the contract would revert on underflow.
+///
+/// ```
+/// Uint256 balance = AbiDecoder{result}.uint256(0);
+/// Uint256 total   = balance + Uint256::fromHex("0x1bf08eb000");
+/// std::cout << total;  // NOTE: Printed in decimal
+/// ```
+class Uint256 {
+public:
+    constexpr Uint256() = default;
+    constexpr Uint256(uint64_t value) : limbs{value, 0, 0, 0} {}
+
+    /// Parse big-endian hex with or without a 0x prefix, e.g. a word of ABI
+    /// data or a JSON-RPC quantity. Throws if the hex is malformed or the value
+    /// does not fit into 256 bits.
+    static Uint256 fromHex(std::string_view hex);
+
+    static constexpr Uint256 fromBigEndian(std::span<const uint8_t, 32> bytes) {
+        Uint256 result;
+        for (size_t i = 0; i < bytes.size(); i++)
+            result.limbs[3 - i / 8] |= static_cast<uint64_t>(bytes[i]) << (56 - (i % 8) * 8);
+        return result;
+    }
+
+    constexpr std::array<uint8_t, 32> toBigEndian() const {
+        std::array<uint8_t, 32> result = {};
+        for (size_t i = 0; i < result.size(); i++)
+            result[i] = static_cast<uint8_t>(limbs[3 - i / 8] >> (56 - (i % 8) * 8));
+        return result;
+    }
+
+    /// Write the value as 64 zero padded lower-case hex digits into `dst`
+    void toHex(std::span<char, 64> dst) const;
+
+    /// 64 zero padded lower-case hex digits without a 0x prefix
+    std::string toHex() const;
+
+    /// The value in decimal
+    std::string toString() const;
+
+    constexpr bool fitsUint64() const { return (limbs[1] | limbs[2] | limbs[3]) == 0; }
+
+    /// The value as a 64 bit integer, throws if it does not fit
+    uint64_t toUint64() const;
+
+    constexpr Uint256& operator+=(const Uint256& rhs) {
+        uint64_t carry = 0;
+        for (size_t i = 0; i < limbs.size(); i++) {
+            uint64_t sum = limbs[i] + carry;
+            carry        = sum < carry;
+            limbs[i]     = sum + rhs.limbs[i];
+            carry       += limbs[i] < sum;
+        }
+        return *this;
+    }
+
+    constexpr Uint256& operator-=(const Uint256& rhs) {
+        uint64_t borrow = 0;
+        for (size_t i = 0; i < limbs.size(); i++) {
+            uint64_t difference = limbs[i] - rhs.limbs[i];
+            uint64_t underflow  = limbs[i] < rhs.limbs[i];
+            limbs[i]            = difference - borrow;
+            borrow              = underflow | (difference < borrow);
+        }
+        return *this;
+    }
+
+    constexpr Uint256& operator*=(const Uint256& rhs) {
+        // NOTE: Schoolbook multiplication, the limbs beyond 256 bits are discarded
+        Uint256 result;
+        for (size_t i = 0; i < limbs.size(); i++) {
+            uint64_t carry = 0;
+            for (size_t j = 0; i + j < limbs.size(); j++) {
+                uint64_t high = 0;
+                uint64_t low  = mul64(limbs[i], rhs.limbs[j], high);
+                uint64_t sum  = result.limbs[i + j] + low;
+                high         += sum < low;
+                sum          += carry;
+                high         += sum < carry;
+                result.limbs[i + j] = sum;
+                carry               = high;
+            }
+        }
+        return *this = result;
+    }
+
+    friend constexpr Uint256 operator+(Uint256 lhs, const Uint256& rhs) { return lhs += rhs; }
+    friend constexpr Uint256 operator-(Uint256 lhs, const Uint256& rhs) { return lhs -= rhs; }
+    friend constexpr Uint256 operator*(Uint256 lhs, const Uint256& rhs) { return lhs *= rhs; }
+
+    friend constexpr bool operator==(const Uint256& lhs, const Uint256& rhs) = default;
+    friend constexpr std::strong_ordering operator<=>(const Uint256& lhs, const Uint256& rhs) {
+        for (size_t i = lhs.limbs.size(); i-- > 0;) {
+            if (lhs.limbs[i] != rhs.limbs[i])
+                return lhs.limbs[i] <=> rhs.limbs[i];
+        }
+        return std::strong_ordering::equal;
+    }
+
+    std::array<uint64_t, 4> limbs = {}; // NOTE: Least significant limb first
+
+private:
+    /// Full 128 bit product of `a` and `b`, returns the low half and writes the
+    /// high half to `high`
+    static constexpr uint64_t mul64(uint64_t a, uint64_t b, uint64_t& high) {
+        const uint64_t MASK   = 0xffffffff;
+        uint64_t       p00    = (a & MASK) * (b & MASK);
+        uint64_t       p01    = (a & MASK) * (b >> 32);
+        uint64_t       p10    = (a >> 32) * (b & MASK);
+        uint64_t       p11    = (a >> 32) * (b >> 32);
+        uint64_t       middle = (p00 >> 32) + (p01 & MASK) + (p10 & MASK);
+        high                  = p11 + (p01 >> 32) + (p10 >> 32) + (middle >> 32);
+        return (middle << 32) | (p00 & MASK);
+    }
+};
+
+/// Prints the value in decimal
+std::ostream& operator<<(std::ostream& stream, const Uint256& value);
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/// Fixed size pool of worker threads that executes submitted tasks in FIFO
+/// order. Tasks must not block on the completion of other tasks submitted to
+/// the same pool otherwise the pool can deadlock once every worker is waiting.
+class WorkerPool {
+public:
+    /// Spawn `threadCount` workers, if 0 is passed in the number of hardware
+    /// threads is used instead. At least 1 worker is always spawned.
+    explicit WorkerPool(size_t threadCount = 0);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&)            = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    size_t size() const { return workers.size(); }
+
+    template <typename F>
+    std::future<std::invoke_result_t<F>> submit(F&& fn);
+
+    /// Split [0, count) into at most `size()` contiguous shards, evaluate
+    /// `mapShard(begin, end)` for each shard on the pool then fold the partial
+    /// results together with `combine` as a binary tree (shard 0 with 1, 2 with
+    /// 3, ... then the survivors pairwise until one remains).
+    ///
+    /// `combine` must be associative for the result to be independent of the
+    /// number of workers. If `count` is 0 then `identity` is returned and if
+    /// only 1 shard is required it is executed on the calling thread.
+    template <typename T, typename MapShard, typename Combine>
+    T reduce(size_t count, T identity, MapShard&& mapShard, Combine&& combine);
+
+    /// Split [0, count) into at most `size()` contiguous shards and evaluate
+    /// `fn(begin, end)` for each shard on the pool, returning once every shard
+    /// has finished. If only 1 shard is required it is executed on the calling
+    /// thread. The first exception thrown by a shard is rethrown.
+    template <typename Fn>
+    void forEachShard(size_t count, Fn&& fn);
+
+private:
+    void run();
+
+    std::vector<std::thread>          workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex                        mutex;
+    std::condition_variable           cv;
+    bool                              stopping = false;
+};
+
+template <typename F>
+std::future<std::invoke_result_t<F>> WorkerPool::submit(F&& fn) {
+    using Result = std::invoke_result_t<F>;
+
+    // NOTE: std::function requires a copyable callable, packaged_task is
+    // move-only so it's stored behind a shared pointer.
+    auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(fn));
+    std::future<Result> result = task->get_future();
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        tasks.emplace_back([task]() { (*task)(); });
+    }
+    cv.notify_one();
+    return result;
+}
+
+template <typename T, typename MapShard, typename Combine>
+T WorkerPool::reduce(size_t count, T identity, MapShard&& mapShard, Combine&& combine) {
+    if (count == 0)
+        return identity;
+
+    const size_t shards = std::min(count, workers.size());
+    if (shards <= 1)
+        return mapShard(size_t{0}, count);
+
+    std::vector<std::future<T>> futures;
+    futures.reserve(shards);
+    for (size_t shard = 0; shard < shards; shard++) {
+        size_t begin = count * shard / shards;
+        size_t end   = count * (shard + 1) / shards;
+        futures.push_back(submit([&mapShard, begin, end]() -> T { return mapShard(begin, end); }));
+    }
+
+    // NOTE: Wait for every shard before collecting the results. If a shard
+    // throws we must not unwind whilst the other shards are still referencing
+    // `mapShard` from this stack frame.
+    for (auto& future : futures)
+        future.wait();
+
+    std::vector<T> partials;
+    partials.reserve(shards);
+    for (auto& future : futures)
+        partials.push_back(future.get());
+
+    // NOTE: Tree reduction of the partial results
+    for (size_t stride = 1; stride < partials.size(); stride *= 2) {
+        for (size_t index = 0; index + stride < partials.size(); index += stride * 2)
+            partials[index] = combine(std::move(partials[index]), partials[index + stride]);
+    }
+    return std::move(partials[0]);
+}
+
+template <typename Fn>
+void WorkerPool::forEachShard(size_t count, Fn&& fn) {
+    if (count == 0)
+        return;
+
+    const size_t shards = std::min(count, workers.size());
+    if (shards <= 1) {
+        fn(size_t{0}, count);
+        return;
+    }
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(shards);
+    for (size_t shard = 0; shard < shards; shard++) {
+        size_t begin = count * shard / shards;
+        size_t end   = count * (shard + 1) / shards;
+        futures.push_back(submit([&fn, begin, end]() { fn(begin, end); }));
+    }
+
+    // NOTE: As in `reduce`, every shard must finish before an exception is
+    // allowed to unwind past `fn`
+    for (auto& future : futures)
+        future.wait();
+    for (auto& future : futures)
+        future.get();
+}
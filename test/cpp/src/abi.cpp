@@ -0,0 +1,202 @@
+#include "service_node_rewards/abi.hpp"
+
+#include "ethyl/utils.hpp"
+#include <oxenc/hex.h>
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+static constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+static void writeHex(char* dst, const uint8_t* src, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        dst[i * 2]     = HEX_DIGITS[src[i] >> 4];
+        dst[i * 2 + 1] = HEX_DIGITS[src[i] & 0xf];
+    }
+}
+
+AbiEncoder::AbiEncoder(std::string_view selector, size_t wordCount) {
+    const size_t SELECTOR_HEX_SIZE = 4 * 2;
+    selector                       = ethyl::utils::trimPrefix(selector, "0x");
+    if (selector.size() != SELECTOR_HEX_SIZE || !oxenc::is_hex(selector)) {
+        std::stringstream stream;
+        stream << "Failed to encode call data, selector '" << selector << "' must be " << SELECTOR_HEX_SIZE << " hex characters";
+        throw std::invalid_argument(stream.str());
+    }
+
+    data.reserve(2 + SELECTOR_HEX_SIZE + wordCount * WORD_HEX_SIZE);
+    data += "0x";
+    data += selector;
+}
+
+char* AbiEncoder::reserveWords(size_t count) {
+    size_t size = data.size();
+    data.resize(size + count * WORD_HEX_SIZE, '0');
+    return data.data() + size;
+}
+
+AbiEncoder& AbiEncoder::uint(uint64_t value) {
+    char* dst = reserveWords(1) + WORD_HEX_SIZE;
+    for (; value; value >>= 4)
+        *--dst = HEX_DIGITS[value & 0xf];
+    return *this;
+}
+
+AbiEncoder& AbiEncoder::uint(const Uint256& value) {
+    value.toHex(std::span<char, WORD_HEX_SIZE>(reserveWords(1), WORD_HEX_SIZE));
+    return *this;
+}
+
+AbiEncoder& AbiEncoder::address(std::string_view hex) {
+    const size_t ADDRESS_HEX_SIZE = 20 * 2;
+    hex                           = ethyl::utils::trimPrefix(hex, "0x");
+    if (hex.size() > ADDRESS_HEX_SIZE || !oxenc::is_hex(hex)) {
+        std::stringstream stream;
+        stream << "Failed to encode address '" << hex << "': An address is at most " << ADDRESS_HEX_SIZE << " hex characters";
+        throw std::invalid_argument(stream.str());
+    }
+    char* dst = reserveWords(1) + WORD_HEX_SIZE - hex.size();
+    std::memcpy(dst, hex.data(), hex.size());
+    return *this;
+}
+
+AbiEncoder& AbiEncoder::words(std::string_view hex) {
+    hex = ethyl::utils::trimPrefix(hex, "0x");
+    if (hex.size() % WORD_HEX_SIZE != 0 || !oxenc::is_hex(hex)) {
+        std::stringstream stream;
+        stream << "Failed to encode words, hex must be a multiple of " << WORD_HEX_SIZE << " hex characters, input hex was " << hex.size() << " characters";
+        throw std::invalid_argument(stream.str());
+    }
+    data += hex;
+    return *this;
+}
+
+AbiEncoder& AbiEncoder::leftPadded(std::span<const uint8_t> payload, size_t wordCount) {
+    if (payload.size() > wordCount * WORD_SIZE) {
+        std::stringstream stream;
+        stream << "Failed to encode " << payload.size() << " bytes into " << wordCount << " words";
+        throw std::invalid_argument(stream.str());
+    }
+    char* dst = reserveWords(wordCount) + (wordCount * WORD_SIZE - payload.size()) * 2;
+    writeHex(dst, payload.data(), payload.size());
+    return *this;
+}
+
+AbiEncoder& AbiEncoder::offset(size_t headWords) {
+    return uint(headWords * WORD_SIZE);
+}
+
+AbiEncoder& AbiEncoder::uintArray(std::span<const uint64_t> values) {
+    uint(values.size());
+    for (uint64_t value : values)
+        uint(value);
+    return *this;
+}
+
+AbiEncoder& AbiEncoder::bytes(std::span<const uint8_t> payload) {
+    uint(payload.size());
+    char* dst = reserveWords(bytesWords(payload.size()) - 1);
+    writeHex(dst, payload.data(), payload.size());
+    return *this;
+}
+
+AbiEncoder& AbiEncoder::bytesHex(std::string_view hex) {
+    hex = ethyl::utils::trimPrefix(hex, "0x");
+    if (!oxenc::is_hex(hex)) {
+        std::stringstream stream;
+        stream << "Failed to encode bytes, '" << hex << "' is not valid hex";
+        throw std::invalid_argument(stream.str());
+    }
+    uint(hex.size() / 2);
+    char* dst = reserveWords(bytesWords(hex.size() / 2) - 1);
+    std::memcpy(dst, hex.data(), hex.size());
+    return *this;
+}
+
+AbiDecoder::AbiDecoder(std::string_view data) {
+    data = ethyl::utils::trimPrefix(data, "0x");
+    if (data.size() % AbiEncoder::WORD_HEX_SIZE != 0 || !oxenc::is_hex(data)) {
+        std::stringstream stream;
+        stream << "Failed to decode ABI data, hex must be a multiple of " << AbiEncoder::WORD_HEX_SIZE << " hex characters, input hex was " << data.size() << " characters";
+        throw std::invalid_argument(stream.str());
+    }
+    hex = data;
+}
+
+std::string_view AbiDecoder::wordsHex(size_t index, size_t count) const {
+    if (index > words() || count > words() - index) {
+        std::stringstream stream;
+        stream << "Failed to decode words [" << index << ", " << index + count << "), ABI data only has " << words() << " words";
+        throw std::out_of_range(stream.str());
+    }
+    return hex.substr(index * AbiEncoder::WORD_HEX_SIZE, count * AbiEncoder::WORD_HEX_SIZE);
+}
+
+std::string_view AbiDecoder::word(size_t index) const {
+    return wordsHex(index, 1);
+}
+
+AbiDecoder AbiDecoder::tail(size_t index) const {
+    uint64_t offset = uint64(index);
+    if (offset % AbiEncoder::WORD_SIZE != 0 || offset / AbiEncoder::WORD_SIZE > words()) {
+        std::stringstream stream;
+        stream << "Failed to decode dynamic value at word " << index << ", offset " << offset << " is not a word boundary within the " << words() << " words of ABI data";
+        throw std::out_of_range(stream.str());
+    }
+    AbiDecoder result;
+    result.hex = hex.substr(static_cast<size_t>(offset) * 2);
+    return result;
+}
+
+AbiDecoder AbiDecoder::slice(size_t index) const {
+    AbiDecoder result;
+    result.hex = wordsHex(index, words() - std::min(index, words()));
+    return result;
+}
+
+std::string_view AbiDecoder::bytesHex(size_t index) const {
+    AbiDecoder value = tail(index);
+    uint64_t   size  = value.uint64(0);
+    if (size > (value.words() - 1) * AbiEncoder::WORD_SIZE) {
+        std::stringstream stream;
+        stream << "Failed to decode bytes at word " << index << ", " << size << " bytes exceeds the ABI data";
+        throw std::out_of_range(stream.str());
+    }
+    return value.hex.substr(AbiEncoder::WORD_HEX_SIZE, static_cast<size_t>(size) * 2);
+}
+
+uint64_t AbiDecoder::uint64(size_t index) const {
+    const size_t     U64_HEX_SIZE = sizeof(uint64_t) * 2;
+    std::string_view value        = word(index);
+    std::string_view high         = value.substr(0, value.size() - U64_HEX_SIZE);
+    if (high.find_first_not_of('0') != std::string_view::npos) {
+        std::stringstream stream;
+        stream << "Failed to decode word " << index << " '" << value << "', the value does not fit into a 64 bit integer";
+        throw std::overflow_error(stream.str());
+    }
+
+    uint64_t result = 0;
+    for (char ch : value.substr(high.size()))
+        result = (result << 4) | static_cast<uint64_t>(oxenc::from_hex_digit(static_cast<unsigned char>(ch)));
+    return result;
+}
+
+Uint256 AbiDecoder::uint256(size_t index) const {
+    return Uint256::fromHex(word(index));
+}
+
+std::array<uint8_t, 20> AbiDecoder::address(size_t index) const {
+    std::string_view        value = word(index);
+    std::array<uint8_t, 20> result;
+    oxenc::from_hex(value.end() - result.size() * 2, value.end(), result.begin());
+    return result;
+}
+
+std::array<uint8_t, 32> AbiDecoder::bytes32(size_t index) const {
+    std::string_view        value = word(index);
+    std::array<uint8_t, 32> result;
+    oxenc::from_hex(value.begin(), value.end(), result.begin());
+    return result;
+}
@@ -0,0 +1,141 @@
+#include "service_node_rewards/contract_events.hpp"
+
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+#include "ethyl/utils.hpp"
+#include "service_node_rewards/abi.hpp"
+#include "service_node_rewards/ec_utils.hpp"
+
+static std::string_view topic(const nlohmann::json& log, size_t index) {
+    const nlohmann::json& topics = log.at("topics");
+    if (index >= topics.size()) {
+        std::stringstream stream;
+        stream << "Log is missing topic " << index << ": " << log.dump();
+        throw std::runtime_error(stream.str());
+    }
+    return topics[index].get_ref<const nlohmann::json::string_t&>();
+}
+
+std::optional<ContractEvent> ContractEvent::decode(const nlohmann::json& log) {
+    // NOTE: Word indices into the (non-indexed) data of each event
+    enum NewServiceNodeWord : size_t {
+        NewServiceNodeInitiator,
+        NewServiceNodePubkeyX,
+        NewServiceNodePubkeyY,
+        NewServiceNodeEd25519Pubkey,
+        NewServiceNodeSignature1,
+        NewServiceNodeSignature2,
+        NewServiceNodeFee,
+        NewServiceNodeContributorsOffset,
+    };
+
+    enum NewSeededServiceNodeWord : size_t {
+        NewSeededServiceNodePubkeyX,
+        NewSeededServiceNodePubkeyY,
+        NewSeededServiceNodeEd25519Pubkey,
+    };
+
+    enum ExitRequestWord : size_t {
+        ExitRequestContributor,
+        ExitRequestPubkeyX,
+    };
+
+    enum ExitWord : size_t {
+        ExitOperator,
+        ExitReturnedAmount,
+        ExitPubkeyX,
+    };
+
+    enum LiquidatedWord : size_t {
+        LiquidatedOperator,
+        LiquidatedPubkeyX,
+    };
+
+    enum ContributorWord : size_t {
+        ContributorAddress,
+        ContributorBeneficiaryAddress,
+        ContributorAmount,
+        ContributorWordCount,
+    };
+
+    const nlohmann::json& topics = log.at("topics");
+    if (topics.empty())
+        return std::nullopt; // NOTE: Anonymous event, not emitted by the rewards contract
+
+    std::string_view eventTopic = topic(log, 0);
+    AbiDecoder       data{log.at("data").get_ref<const nlohmann::json::string_t&>()};
+
+    ContractEvent result = {};
+    if (eventTopic == NEW_SERVICE_NODE_V2.view()) {
+        NewServiceNodeEvent event = {};
+        event.serviceNodeID       = AbiDecoder{topic(log, 1)}.uint64(0);
+        event.initiator           = data.address(NewServiceNodeInitiator);
+        event.pubkey              = utils::HexToBLSPublicKey(data.wordsHex(NewServiceNodePubkeyX, 2));
+        event.ed25519Pubkey       = data.bytes32(NewServiceNodeEd25519Pubkey);
+
+        uint64_t fee = data.uint64(NewServiceNodeFee);
+        if (fee > std::numeric_limits<uint16_t>::max()) {
+            std::stringstream stream;
+            stream << "New service node event has a fee " << fee << " that does not fit into a uint16";
+            throw std::runtime_error(stream.str());
+        }
+        event.fee = static_cast<uint16_t>(fee);
+
+        AbiDecoder contributors      = data.tail(NewServiceNodeContributorsOffset);
+        uint64_t   contributor_count = contributors.uint64(0);
+        event.contributors.resize(contributor_count);
+        for (size_t i = 0; i < contributor_count; i++) {
+            Contributor& c       = event.contributors[i];
+            size_t       base    = 1 + i * ContributorWordCount;
+            c.address            = contributors.address(base + ContributorAddress);
+            c.beneficiaryAddress = contributors.address(base + ContributorBeneficiaryAddress);
+            c.amount             = contributors.uint256(base + ContributorAmount);
+        }
+        result.data = std::move(event);
+    } else if (eventTopic == NEW_SEEDED_SERVICE_NODE.view()) {
+        NewSeededServiceNodeEvent event = {};
+        event.serviceNodeID             = AbiDecoder{topic(log, 1)}.uint64(0);
+        event.pubkey                    = utils::HexToBLSPublicKey(data.wordsHex(NewSeededServiceNodePubkeyX, 2));
+        event.ed25519Pubkey             = data.bytes32(NewSeededServiceNodeEd25519Pubkey);
+        result.data                     = std::move(event);
+    } else if (eventTopic == SERVICE_NODE_EXIT_REQUEST.view()) {
+        ServiceNodeExitRequestEvent event = {};
+        event.serviceNodeID               = AbiDecoder{topic(log, 1)}.uint64(0);
+        event.contributor                 = data.address(ExitRequestContributor);
+        event.pubkey                      = utils::HexToBLSPublicKey(data.wordsHex(ExitRequestPubkeyX, 2));
+        result.data                       = std::move(event);
+    } else if (eventTopic == SERVICE_NODE_EXIT.view()) {
+        ServiceNodeExitEvent event = {};
+        event.serviceNodeID        = AbiDecoder{topic(log, 1)}.uint64(0);
+        event.operatorAddress      = data.address(ExitOperator);
+        event.returnedAmount       = data.uint256(ExitReturnedAmount);
+        event.pubkey               = utils::HexToBLSPublicKey(data.wordsHex(ExitPubkeyX, 2));
+        result.data                = std::move(event);
+    } else if (eventTopic == SERVICE_NODE_LIQUIDATED.view()) {
+        ServiceNodeLiquidatedEvent event = {};
+        event.serviceNodeID              = AbiDecoder{topic(log, 1)}.uint64(0);
+        event.operatorAddress            = data.address(LiquidatedOperator);
+        event.pubkey                     = utils::HexToBLSPublicKey(data.wordsHex(LiquidatedPubkeyX, 2));
+        result.data                      = std::move(event);
+    } else if (eventTopic == REWARDS_BALANCE_UPDATED.view()) {
+        RewardsBalanceUpdatedEvent event = {};
+        event.recipient                  = AbiDecoder{topic(log, 1)}.address(0);
+        event.amount                     = data.uint256(0);
+        event.previousBalance            = data.uint256(1);
+        result.data                      = std::move(event);
+    } else if (eventTopic == REWARDS_CLAIMED.view()) {
+        RewardsClaimedEvent event = {};
+        event.recipient           = AbiDecoder{topic(log, 1)}.address(0);
+        event.amount              = data.uint256(0);
+        result.data               = std::move(event);
+    } else {
+        return std::nullopt;
+    }
+
+    result.blockNumber     = ethyl::utils::hexStringToU64(log.at("blockNumber").get<std::string>());
+    result.logIndex        = ethyl::utils::hexStringToU64(log.at("logIndex").get<std::string>());
+    result.transactionHash = log.at("transactionHash").get<std::string>();
+    return result;
+}
@@ -0,0 +1,248 @@
+#include "service_node_rewards/contract_state_file.hpp"
+
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "service_node_rewards/ec_utils.hpp"
+
+// NOTE: The records are mapped directly from disk, the layout must be
+// identical on every platform that reads the file
+static_assert(std::endian::native == std::endian::little, "Snapshot records are stored little-endian");
+static_assert(std::is_trivially_copyable_v<ContractStateFile::Header> && sizeof(ContractStateFile::Header) == 112);
+static_assert(std::is_trivially_copyable_v<ContractStateFile::NodeRecord> && sizeof(ContractStateFile::NodeRecord) == 152);
+static_assert(std::is_trivially_copyable_v<ContractStateFile::ContributorRecord> && sizeof(ContractStateFile::ContributorRecord) == 72);
+static_assert(std::is_trivially_copyable_v<ContractStateFile::RecipientRecord> && sizeof(ContractStateFile::RecipientRecord) == 88);
+
+template <typename T>
+static void append(std::vector<unsigned char>& buffer, const T& value) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(value));
+}
+
+static std::runtime_error fileError(std::string_view action, const std::filesystem::path& path) {
+    std::stringstream stream;
+    stream << "Failed to " << action << " contract state snapshot " << path << ": " << std::strerror(errno);
+    return std::runtime_error(stream.str());
+}
+
+void ContractStateFile::write(const std::filesystem::path& path, const ContractStateMirror& mirror, const bls::PublicKey& aggregatePubkey, uint64_t blockHeight) {
+    size_t contributorCount = 0;
+    for (const auto& [id, node] : mirror.nodes)
+        contributorCount += node.contributors.size();
+
+    if (contributorCount > std::numeric_limits<uint32_t>::max()) {
+        std::stringstream stream;
+        stream << "Contract state has " << contributorCount << " contributors, more than a snapshot can index";
+        throw std::runtime_error(stream.str());
+    }
+
+    Header header           = {};
+    header.magic            = MAGIC;
+    header.version          = VERSION;
+    header.blockHeight      = blockHeight;
+    header.nodeCount        = mirror.nodes.size();
+    header.contributorCount = contributorCount;
+    header.recipientCount   = mirror.recipients.size();
+    header.aggregatePubkey  = utils::BLSPublicKeyToBytes(aggregatePubkey);
+
+    std::vector<unsigned char> buffer;
+    buffer.reserve(sizeof(Header) + mirror.nodes.size() * sizeof(NodeRecord) + contributorCount * sizeof(ContributorRecord) + mirror.recipients.size() * sizeof(RecipientRecord));
+    append(buffer, header);
+
+    uint32_t contributorBegin = 0;
+    for (auto it = mirror.nodes.begin(); it != mirror.nodes.end(); it++) {
+        const auto& [id, node] = *it;
+
+        NodeRecord record       = {};
+        record.id               = id;
+        record.prev             = it == mirror.nodes.begin() ? 0 : std::prev(it)->first;
+        record.next             = std::next(it) == mirror.nodes.end() ? 0 : std::next(it)->first;
+        record.pubkey           = utils::BLSPublicKeyToBytes(node.pubkey);
+        record.ed25519Pubkey    = node.ed25519Pubkey;
+        record.operatorAddress  = node.operatorAddress;
+        record.fee              = node.fee;
+        record.leaveRequested   = node.leaveRequested;
+        record.contributorBegin = contributorBegin;
+        record.contributorCount = static_cast<uint32_t>(node.contributors.size());
+        contributorBegin += record.contributorCount;
+        append(buffer, record);
+    }
+
+    for (const auto& [id, node] : mirror.nodes) {
+        for (const Contributor& contributor : node.contributors) {
+            ContributorRecord record  = {};
+            record.address            = contributor.address;
+            record.beneficiaryAddress = contributor.beneficiaryAddress;
+            record.amount             = contributor.amount;
+            append(buffer, record);
+        }
+    }
+
+    for (const auto& [address, recipient] : mirror.recipients) {
+        RecipientRecord record = {};
+        record.address         = address;
+        record.rewards         = recipient.rewards;
+        record.claimed         = recipient.claimed;
+        append(buffer, record);
+    }
+
+    std::filesystem::path tmpPath = path;
+    tmpPath += ".tmp";
+
+    int fd = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1)
+        throw fileError("create", tmpPath);
+
+    for (size_t written = 0; written < buffer.size();) {
+        ssize_t bytes = ::write(fd, buffer.data() + written, buffer.size() - written);
+        if (bytes == -1) {
+            if (errno == EINTR)
+                continue;
+            std::runtime_error error = fileError("write", tmpPath);
+            ::close(fd);
+            throw error;
+        }
+        written += static_cast<size_t>(bytes);
+    }
+
+    // NOTE: Flush the contents before the rename so a crash can't leave an
+    // empty or truncated file at `path`
+    if (::fsync(fd) == -1) {
+        std::runtime_error error = fileError("flush", tmpPath);
+        ::close(fd);
+        throw error;
+    }
+    ::close(fd);
+    std::filesystem::rename(tmpPath, path);
+}
+
+ContractStateFile::ContractStateFile(const std::filesystem::path& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+        throw fileError("open", path);
+
+    struct stat info = {};
+    if (::fstat(fd, &info) == -1) {
+        std::runtime_error error = fileError("stat", path);
+        ::close(fd);
+        throw error;
+    }
+
+    size = static_cast<size_t>(info.st_size);
+    if (size < sizeof(Header)) {
+        ::close(fd);
+        std::stringstream stream;
+        stream << "Contract state snapshot " << path << " is " << size << " bytes, smaller than its header";
+        throw std::runtime_error(stream.str());
+    }
+
+    void* memory = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // NOTE: The mapping keeps the file referenced
+    if (memory == MAP_FAILED)
+        throw fileError("map", path);
+    mapping = static_cast<const unsigned char*>(memory);
+
+    const Header& h = header();
+    std::stringstream stream;
+    if (h.magic != MAGIC || h.version != VERSION) {
+        stream << "Contract state snapshot " << path << " has an unrecognised magic or version " << h.version << ", expected version " << VERSION;
+    } else {
+        // NOTE: Each count is bounded by the file size before multiplying so
+        // a corrupt count can't overflow the expected size
+        size_t remaining = size - sizeof(Header);
+        if (h.nodeCount > remaining / sizeof(NodeRecord) || h.contributorCount > remaining / sizeof(ContributorRecord) || h.recipientCount > remaining / sizeof(RecipientRecord) ||
+            h.nodeCount * sizeof(NodeRecord) + h.contributorCount * sizeof(ContributorRecord) + h.recipientCount * sizeof(RecipientRecord) != remaining) {
+            stream << "Contract state snapshot " << path << " record counts (" << h.nodeCount << " nodes, " << h.contributorCount << " contributors, " << h.recipientCount << " recipients) do not match its size of " << size << " bytes";
+        } else {
+            for (const NodeRecord& node : nodes()) {
+                if (node.contributorBegin > h.contributorCount || node.contributorCount > h.contributorCount - node.contributorBegin) {
+                    stream << "Contract state snapshot " << path << " node " << node.id << " references contributors outside of the snapshot";
+                    break;
+                }
+            }
+        }
+    }
+
+    if (stream.tellp() > 0) {
+        ::munmap(const_cast<unsigned char*>(mapping), size);
+        mapping = nullptr;
+        throw std::runtime_error(stream.str());
+    }
+}
+
+ContractStateFile::~ContractStateFile() {
+    if (mapping)
+        ::munmap(const_cast<unsigned char*>(mapping), size);
+}
+
+ContractStateFile::ContractStateFile(ContractStateFile&& other) noexcept : mapping(other.mapping), size(other.size) {
+    other.mapping = nullptr;
+    other.size    = 0;
+}
+
+ContractStateFile& ContractStateFile::operator=(ContractStateFile&& other) noexcept {
+    if (this != &other) {
+        if (mapping)
+            ::munmap(const_cast<unsigned char*>(mapping), size);
+        mapping       = other.mapping;
+        size          = other.size;
+        other.mapping = nullptr;
+        other.size    = 0;
+    }
+    return *this;
+}
+
+std::span<const ContractStateFile::NodeRecord> ContractStateFile::nodes() const {
+    const auto* begin = reinterpret_cast<const NodeRecord*>(mapping + sizeof(Header));
+    return {begin, static_cast<size_t>(header().nodeCount)};
+}
+
+std::span<const ContractStateFile::ContributorRecord> ContractStateFile::contributors() const {
+    const auto* begin = reinterpret_cast<const ContributorRecord*>(mapping + sizeof(Header) + nodes().size_bytes());
+    return {begin, static_cast<size_t>(header().contributorCount)};
+}
+
+std::span<const ContractStateFile::RecipientRecord> ContractStateFile::recipients() const {
+    const auto* begin = reinterpret_cast<const RecipientRecord*>(mapping + sizeof(Header) + nodes().size_bytes() + contributors().size_bytes());
+    return {begin, static_cast<size_t>(header().recipientCount)};
+}
+
+ContractStateMirror ContractStateFile::toMirror() const {
+    ContractStateMirror                result;
+    std::span<const ContributorRecord> allContributors = contributors();
+    for (const NodeRecord& record : nodes()) {
+        MirroredServiceNode node = {};
+        node.operatorAddress     = record.operatorAddress;
+        node.pubkey              = utils::BytesToBLSPublicKey(record.pubkey);
+        node.ed25519Pubkey       = record.ed25519Pubkey;
+        node.fee                 = record.fee;
+        node.leaveRequested      = record.leaveRequested != 0;
+
+        node.contributors.reserve(record.contributorCount);
+        for (const ContributorRecord& contributor : allContributors.subspan(record.contributorBegin, record.contributorCount))
+            node.contributors.push_back(Contributor{contributor.address, contributor.beneficiaryAddress, contributor.amount});
+
+        // NOTE: Records are in ID order, insert at the end of the map
+        result.nodes.emplace_hint(result.nodes.end(), record.id, std::move(node));
+    }
+
+    for (const RecipientRecord& record : recipients())
+        result.recipients.emplace_hint(result.recipients.end(), record.address, Recipient{record.rewards, record.claimed});
+    return result;
+}
+
+bls::PublicKey ContractStateFile::aggregatePubkey() const {
+    return utils::BytesToBLSPublicKey(header().aggregatePubkey);
+}
@@ -0,0 +1,113 @@
+#include "service_node_rewards/contract_sync.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+
+#include "ethyl/utils.hpp"
+#include "service_node_rewards/json_rpc_batch.hpp"
+
+void ContractStateMirror::apply(const ContractEvent& event) {
+    if (auto* added = std::get_if<NewServiceNodeEvent>(&event.data)) {
+        MirroredServiceNode& node = nodes[added->serviceNodeID];
+        node.operatorAddress      = added->initiator;
+        node.pubkey               = added->pubkey;
+        node.ed25519Pubkey        = added->ed25519Pubkey;
+        node.fee                  = added->fee;
+        node.contributors         = added->contributors;
+        node.leaveRequested       = false;
+    } else if (auto* seeded = std::get_if<NewSeededServiceNodeEvent>(&event.data)) {
+        MirroredServiceNode& node = nodes[seeded->serviceNodeID];
+        node                      = {};
+        node.pubkey               = seeded->pubkey;
+        node.ed25519Pubkey        = seeded->ed25519Pubkey;
+    } else if (auto* request = std::get_if<ServiceNodeExitRequestEvent>(&event.data)) {
+        if (auto it = nodes.find(request->serviceNodeID); it != nodes.end())
+            it->second.leaveRequested = true;
+    } else if (auto* exit = std::get_if<ServiceNodeExitEvent>(&event.data)) {
+        nodes.erase(exit->serviceNodeID);
+    } else if (auto* liquidated = std::get_if<ServiceNodeLiquidatedEvent>(&event.data)) {
+        nodes.erase(liquidated->serviceNodeID);
+    } else if (auto* updated = std::get_if<RewardsBalanceUpdatedEvent>(&event.data)) {
+        auto [it, inserted] = recipients.try_emplace(updated->recipient, 0, 0);
+        it->second.rewards  = updated->amount;
+    } else if (auto* claimed = std::get_if<RewardsClaimedEvent>(&event.data)) {
+        auto [it, inserted] = recipients.try_emplace(claimed->recipient, 0, 0);
+        it->second.claimed += claimed->amount;
+    }
+}
+
+ContractEventSyncer::ContractEventSyncer(std::string _url, std::string _contractAddress, uint64_t _startBlock)
+    : url(std::move(_url))
+    , contractAddress(std::move(_contractAddress))
+    , startBlock(_startBlock) {
+}
+
+static std::string quantityToHex(uint64_t value) {
+    std::stringstream stream;
+    stream << "0x" << std::hex << value;
+    return stream.str();
+}
+
+size_t ContractEventSyncer::sync(ContractStateMirror& mirror, uint64_t confirmations) {
+    JsonRpcBatch batch{url};
+    batch.request("eth_blockNumber", nlohmann::json::array());
+    uint64_t head = ethyl::utils::hexStringToU64(batch.execute()[0].get<std::string>());
+    if (head < confirmations)
+        return 0;
+
+    const uint64_t target = head - confirmations;
+    uint64_t       from   = lastBlock ? *lastBlock + 1 : startBlock;
+    size_t         result = 0;
+    while (from <= target) {
+        pageSize    = std::max<uint64_t>(pageSize, 1);
+        uint64_t to = from + std::min(target - from, pageSize - 1);
+
+        nlohmann::json filter = {
+                {"address", contractAddress},
+                {"fromBlock", quantityToHex(from)},
+                {"toBlock", quantityToHex(to)},
+        };
+        batch.request("eth_getLogs", nlohmann::json::array({std::move(filter)}));
+
+        std::vector<nlohmann::json> errors;
+        std::vector<nlohmann::json> logs = batch.execute(errors);
+        if (!errors[0].is_null()) {
+            if (from == to) {
+                std::stringstream stream;
+                stream << "Failed to retrieve the logs of block " << from << " for contract " << contractAddress << ": " << errors[0].dump();
+                throw std::runtime_error(stream.str());
+            }
+
+            // NOTE: Too many logs or too large a range for the provider, retry
+            // with a smaller page
+            pageSize = (to - from + 1) / 2;
+            continue;
+        }
+
+        std::vector<ContractEvent> events;
+        for (const nlohmann::json& log : logs[0]) {
+            if (log.value("removed", false))
+                continue;
+            if (std::optional<ContractEvent> event = ContractEvent::decode(log))
+                events.push_back(std::move(*event));
+        }
+
+        std::sort(events.begin(), events.end(), [](const ContractEvent& lhs, const ContractEvent& rhs) {
+            return std::tie(lhs.blockNumber, lhs.logIndex) < std::tie(rhs.blockNumber, rhs.logIndex);
+        });
+        for (const ContractEvent& event : events)
+            mirror.apply(event);
+
+        result += events.size();
+        lastBlock = to;
+        from      = to + 1;
+    }
+
+    return result;
+}
+
+void ContractEventSyncer::setCheckpoint(uint64_t block) {
+    lastBlock = block;
+}
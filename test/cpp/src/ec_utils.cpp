@@ -3,7 +3,9 @@
 #include <oxenc/hex.h>
 
 #include <cybozu/endian.hpp>
+#include <algorithm>
 #include <cstring>
+#include <sstream>
 
 extern "C" {
 #include <crypto/keccak.h>
@@ -28,11 +30,11 @@ std::string utils::SignatureToHex(bls::Signature sig) {
     return oxenc::to_hex(serialized_signature.begin(), serialized_signature.end());
 }
 
-std::string utils::BLSPublicKeyToHex(const bls::PublicKey& publicKey) {
-    const mclSize                                     KEY_SIZE         = 32;
-    std::array<char, KEY_SIZE * 2 /*X, Y component*/> serializedKeyHex = {};
+std::array<uint8_t, 64> utils::BLSPublicKeyToBytes(const bls::PublicKey& publicKey) {
+    const mclSize                                        KEY_SIZE      = 32;
+    std::array<uint8_t, KEY_SIZE * 2 /*X, Y component*/> serializedKey = {};
 
-    char*               dst     = serializedKeyHex.data();
+    uint8_t*            dst     = serializedKey.data();
     const blsPublicKey* rawKey  = publicKey.getPtr();
 
     mcl::bn::G1 g1Point = {};
@@ -51,36 +53,43 @@ std::string utils::BLSPublicKeyToHex(const bls::PublicKey& publicKey) {
         throw std::runtime_error("size of x is zero");
     if (g1Point.y.serialize(dst + KEY_SIZE, KEY_SIZE, mcl::IoSerialize | mcl::IoBigEndian) == 0)
         throw std::runtime_error("size of y is zero");
+    return serializedKey;
+}
 
-    std::string result = oxenc::to_hex(serializedKeyHex.begin(), serializedKeyHex.end());
+std::string utils::BLSPublicKeyToHex(const bls::PublicKey& publicKey) {
+    std::array<uint8_t, 64> serializedKey = BLSPublicKeyToBytes(publicKey);
+    std::string             result        = oxenc::to_hex(serializedKey.begin(), serializedKey.end());
     return result;
 }
 
 bls::PublicKey utils::HexToBLSPublicKey(std::string_view hex) {
-    const size_t BLS_PKEY_COMPONENT_HEX_SIZE = 32 * 2;
-    const size_t BLS_PKEY_HEX_SIZE           = BLS_PKEY_COMPONENT_HEX_SIZE * 2;
-    hex                                      = ethyl::utils::trimPrefix(hex, "0x");
+    const size_t BLS_PKEY_HEX_SIZE = 64 * 2;
+    hex                            = ethyl::utils::trimPrefix(hex, "0x");
 
-    if (hex.size() != BLS_PKEY_HEX_SIZE) {
+    if (hex.size() != BLS_PKEY_HEX_SIZE || !oxenc::is_hex(hex)) {
         std::stringstream stream;
         stream << "Failed to deserialize BLS key hex '" << hex << "': A serialized BLS key is " << BLS_PKEY_HEX_SIZE << " hex characters, input hex was " << hex.size() << " characters";
         throw std::runtime_error(stream.str());
     }
 
-    // NOTE: Divide the 2 keys into the X,Y component
-    std::string_view              pkeyXHex = hex.substr(0,                           BLS_PKEY_COMPONENT_HEX_SIZE);
-    std::string_view              pkeyYHex = hex.substr(BLS_PKEY_COMPONENT_HEX_SIZE, BLS_PKEY_COMPONENT_HEX_SIZE);
-    std::array<unsigned char, 32> pkeyX    = ethyl::utils::fromHexString32Byte(pkeyXHex);
-    std::array<unsigned char, 32> pkeyY    = ethyl::utils::fromHexString32Byte(pkeyYHex);
+    std::array<uint8_t, 64> bytes = {};
+    oxenc::from_hex(hex.begin(), hex.end(), bytes.begin());
+    return BytesToBLSPublicKey(bytes);
+}
+
+bls::PublicKey utils::BytesToBLSPublicKey(std::span<const uint8_t, 64> bytes) {
+    const size_t                 BLS_PKEY_COMPONENT_SIZE = 32;
+    std::span<const uint8_t, 32> pkeyX                   = bytes.first<BLS_PKEY_COMPONENT_SIZE>();
+    std::span<const uint8_t, 32> pkeyY                   = bytes.last<BLS_PKEY_COMPONENT_SIZE>();
 
-    // NOTE: In `PublicKeyToHex` before we serialize the G1 point, we normalize
-    // the point which divides X, Y by the Z component. This transformation then
-    // converts the divisor to 1 (Z) as the division has already been applied to
-    // X and Y. Here we reconstruct Z as 1.
+    // NOTE: In `BLSPublicKeyToBytes` before we serialize the G1 point, we
+    // normalize the point which divides X, Y by the Z component. This
+    // transformation then converts the divisor to 1 (Z) as the division has
+    // already been applied to X and Y. Here we reconstruct Z as 1.
     std::array<unsigned char, 32> pkeyZ = {};
     pkeyZ.data()[0]                     = 1;
 
-    // NOTE: This is the reverse of ethyl::utils::PublicKeyToHex (above). We serialize
+    // NOTE: This is the reverse of `BLSPublicKeyToBytes` (above). We serialize
     // a G1 point to conform the required format to interop directly with
     // Solidity's BN256G1 library.
     mcl::bn::G1 g1Point = {};
@@ -97,13 +106,13 @@ bls::PublicKey utils::HexToBLSPublicKey(std::string_view hex) {
 
     if (readX != pkeyX.size()) {
         std::stringstream stream;
-        stream << "Failed to deserialize BLS key 'x' component '" << pkeyXHex << "', input hex was: '" << hex << "'";
+        stream << "Failed to deserialize BLS key 'x' component '" << oxenc::to_hex(pkeyX.begin(), pkeyX.end()) << "', input was: '" << oxenc::to_hex(bytes.begin(), bytes.end()) << "'";
         throw std::runtime_error(stream.str());
     }
 
     if (readY != pkeyY.size()) {
         std::stringstream stream;
-        stream << "Failed to deserialize BLS key 'y' component '" << pkeyYHex << "', input hex was: '" << hex << "'";
+        stream << "Failed to deserialize BLS key 'y' component '" << oxenc::to_hex(pkeyY.begin(), pkeyY.end()) << "', input was: '" << oxenc::to_hex(bytes.begin(), bytes.end()) << "'";
         throw std::runtime_error(stream.str());
     }
 
@@ -234,3 +243,218 @@ void utils::ExpandMessageXMDKeccak256(std::span<uint8_t> out, std::span<const ui
         std::memcpy(out.data() + KECCAK256_OUTPUT_SIZE * i, bi, sizeof(bi));
     }
 }
+
+std::array<uint8_t, 32> utils::BuildTag(std::string_view baseTag, uint32_t chainID, std::string_view contractAddress) {
+    const size_t ETH_ADDRESS_SIZE = 20;
+    contractAddress               = ethyl::utils::trimPrefix(contractAddress, "0x");
+    if (contractAddress.size() != ETH_ADDRESS_SIZE * 2 || !oxenc::is_hex(contractAddress)) {
+        std::stringstream stream;
+        stream << "Failed to build tag '" << baseTag << "': Contract address '" << contractAddress << "' is not a 20 byte hex address";
+        throw std::invalid_argument(stream.str());
+    }
+
+    // NOTE: abi.encodePacked(string baseTag, uint256 chainID, address contractAddress)
+    uint8_t chainIDBytes[32] = {};
+    cybozu::Set32bitAsBE(chainIDBytes + sizeof(chainIDBytes) - sizeof(chainID), chainID);
+
+    uint8_t contractAddressBytes[ETH_ADDRESS_SIZE];
+    oxenc::from_hex(contractAddress.begin(), contractAddress.end(), contractAddressBytes);
+
+    std::array<uint8_t, 32> result = {};
+    KECCAK_CTX ctx = {};
+    keccak_init(&ctx);
+    keccak_update(&ctx, reinterpret_cast<const uint8_t*>(baseTag.data()), baseTag.size());
+    keccak_update(&ctx, chainIDBytes, sizeof(chainIDBytes));
+    keccak_update(&ctx, contractAddressBytes, sizeof(contractAddressBytes));
+    keccak_finish(&ctx, result.data());
+    return result;
+}
+
+mcl::bn::G2 utils::MapToG2(std::span<const uint8_t> msg, std::span<const uint8_t> hashToG2Tag) {
+
+    mcl::bn::G2 result = {};
+    result.clear();
+
+    std::vector<uint8_t> messageWithI(msg.size() + 1);
+    std::memcpy(messageWithI.data(), msg.data(), msg.size());
+
+    for (uint8_t increment = 0;; increment++) {
+        messageWithI[messageWithI.size() - 1] = increment;
+
+        // NOTE: Solidity's BN256G2.hashToField(msg, tag) => x1, x2, b
+        mcl::bn::Fp x1 = {}, x2 = {};
+        bool b = {};
+        {
+            uint8_t expandedBytes[128] = {};
+            utils::ExpandMessageXMDKeccak256(expandedBytes, messageWithI, hashToG2Tag);
+
+            bool converted;
+            x1.setBigEndianMod(&converted, expandedBytes + 0,  48);
+            assert(converted);
+            x2.setBigEndianMod(&converted, expandedBytes + 48, 48);
+            assert(converted);
+
+            b = ((expandedBytes[127] & 1) == 1);
+        }
+
+        // NOTE: herumi/bls MapTo::mapToEC
+        mcl::bn::G2::Fp x = mcl::bn::G2::Fp(x1, x2);
+        mcl::bn::G2::Fp y;
+        mcl::bn::G2::getWeierstrass(y, x);
+        if (mcl::bn::G2::Fp::squareRoot(y, y)) { // Check if this is a point
+            if (b)                               // Let b => {0, 1} to choose between the two roots.
+                y = -y;
+            bool converted;
+            result.set(&converted, x, y, false);
+            assert(converted);
+            return result;                       // Successfully mapped to curve, exit the loop
+        }
+    }
+
+    return result;
+}
+
+mcl::bn::G2 utils::HashToG2(std::span<const uint8_t> msg, std::span<const uint8_t> hashToG2Tag) {
+    mcl::bn::G2 result = utils::MapToG2(msg, hashToG2Tag);
+    mcl::bn::BN::param.mapTo.mulByCofactor(result);
+    return result;
+}
+
+// NOTE: The BLS types wrap the mcl points, reinterpret them to do arithmetic
+// on the underlying point (see SignatureToHex).
+static const mcl::bn::G1& PublicKeyPoint(const bls::PublicKey& key) {
+    return *reinterpret_cast<const mcl::bn::G1*>(&key.getPtr()->v);
+}
+
+static const mcl::bn::G2& SignaturePoint(const bls::Signature& sig) {
+    return *reinterpret_cast<const mcl::bn::G2*>(&sig.getPtr()->v);
+}
+
+static mcl::bn::G1 PublicKeyGenerator() {
+    blsPublicKey generator;
+    blsGetGeneratorOfPublicKey(&generator);
+    return *reinterpret_cast<const mcl::bn::G1*>(&generator.v);
+}
+
+bls::Signature utils::HexToSignature(std::string_view hex) {
+    const size_t COMPONENT_SIZE = 32;
+    const size_t SIGNATURE_SIZE = COMPONENT_SIZE * 4 /*X.a, X.b, Y.a, Y.b*/;
+    hex                         = ethyl::utils::trimPrefix(hex, "0x");
+
+    if (hex.size() != SIGNATURE_SIZE * 2 || !oxenc::is_hex(hex)) {
+        std::stringstream stream;
+        stream << "Failed to deserialize BLS signature hex '" << hex << "': A serialized BLS signature is " << SIGNATURE_SIZE * 2 << " hex characters, input hex was " << hex.size() << " characters";
+        throw std::runtime_error(stream.str());
+    }
+
+    std::array<uint8_t, SIGNATURE_SIZE> bytes;
+    oxenc::from_hex(hex.begin(), hex.end(), bytes.begin());
+
+    bls::Signature result = {};
+    result.clear();
+
+    // NOTE: SignatureToHex serializes the point at infinity as all zeros
+    if (std::all_of(bytes.begin(), bytes.end(), [](uint8_t byte) { return byte == 0; }))
+        return result;
+
+    // NOTE: Reverse of SignatureToHex, the point was normalized before being
+    // serialized so Z is reconstructed as 1.
+    mcl::bn::G2 g2Point = {};
+    g2Point.clear();
+    mcl::bn::Fp* components[] = {&g2Point.x.a, &g2Point.x.b, &g2Point.y.a, &g2Point.y.b};
+    for (size_t index = 0; index < std::size(components); index++) {
+        if (components[index]->deserialize(bytes.data() + COMPONENT_SIZE * index, COMPONENT_SIZE, mcl::IoSerialize | mcl::IoBigEndian) != COMPONENT_SIZE) {
+            std::stringstream stream;
+            stream << "Failed to deserialize BLS signature component " << index << ", input hex was: '" << hex << "'";
+            throw std::runtime_error(stream.str());
+        }
+    }
+    g2Point.z.a = 1;
+    g2Point.z.b = 0;
+
+    if (!g2Point.isValid()) {
+        std::stringstream stream;
+        stream << "Failed to deserialize BLS signature, the point is not on the curve, input hex was: '" << hex << "'";
+        throw std::runtime_error(stream.str());
+    }
+
+    std::memcpy(&result.getPtr()->v.x, &g2Point.x, sizeof(g2Point.x));
+    std::memcpy(&result.getPtr()->v.y, &g2Point.y, sizeof(g2Point.y));
+    std::memcpy(&result.getPtr()->v.z, &g2Point.z, sizeof(g2Point.z));
+    static_assert(sizeof(g2Point) == sizeof(result.getPtr()->v));
+    return result;
+}
+
+bls::PublicKey utils::SignersPubkey(const bls::PublicKey& aggregatePubkey, std::span<const bls::PublicKey> nonSignerPubkeys) {
+    bls::PublicKey result = aggregatePubkey;
+
+    // NOTE: const_cast is legal because the original object was not declared
+    // const
+    mcl::bn::G1& point = *reinterpret_cast<mcl::bn::G1*>(&const_cast<blsPublicKey*>(result.getPtr())->v);
+    for (const bls::PublicKey& nonSigner : nonSignerPubkeys)
+        mcl::bn::G1::sub(point, point, PublicKeyPoint(nonSigner));
+    return result;
+}
+
+bool utils::VerifySignature(const mcl::bn::G2& Hm, const bls::Signature& signature, const bls::PublicKey& pubkey) {
+    // NOTE: e(G1, signature) == e(pubkey, Hm) <=> e(-G1, signature) * e(pubkey, Hm) == 1
+    mcl::bn::G1 P[2];
+    mcl::bn::G2 Q[2];
+    mcl::bn::G1::neg(P[0], PublicKeyGenerator());
+    Q[0] = SignaturePoint(signature);
+    P[1] = PublicKeyPoint(pubkey);
+    Q[1] = Hm;
+
+    mcl::bn::Fp12 e;
+    mcl::bn::millerLoopVec(e, P, Q, std::size(P));
+    mcl::bn::finalExp(e, e);
+    return e.isOne();
+}
+
+bool utils::VerifyAggregateSignature(std::span<const uint8_t> msg,
+                                     std::span<const uint8_t> hashToG2Tag,
+                                     const bls::Signature& signature,
+                                     const bls::PublicKey& aggregatePubkey,
+                                     std::span<const bls::PublicKey> nonSignerPubkeys) {
+    mcl::bn::G2    Hm      = utils::HashToG2(msg, hashToG2Tag);
+    bls::PublicKey signers = utils::SignersPubkey(aggregatePubkey, nonSignerPubkeys);
+    return utils::VerifySignature(Hm, signature, signers);
+}
+
+bool utils::VerifySignatureBatch(std::span<const SignatureCheck> checks) {
+    if (checks.empty())
+        return true;
+
+    // NOTE: Random linear combination of the checks. For random non-zero r_i
+    //
+    //   e(-G1, sum(r_i * sig_i)) * prod(e(r_i * pubkey_i, Hm_i)) == 1
+    //
+    // holds iff every individual check holds (with overwhelming probability).
+    // The Miller loops are accumulated into one product so only one final
+    // exponentiation is executed for the whole batch.
+    std::vector<mcl::bn::G1> P(checks.size() + 1);
+    std::vector<mcl::bn::G2> Q(checks.size() + 1);
+    mcl::bn::G1::neg(P[0], PublicKeyGenerator());
+    Q[0].clear();
+
+    for (size_t index = 0; index < checks.size(); index++) {
+        const SignatureCheck& check = checks[index];
+
+        mcl::bn::Fr r;
+        do {
+            r.setByCSPRNG();
+        } while (r.isZero());
+
+        mcl::bn::G2 weightedSignature;
+        mcl::bn::G2::mul(weightedSignature, SignaturePoint(check.signature), r);
+        mcl::bn::G2::add(Q[0], Q[0], weightedSignature);
+
+        mcl::bn::G1::mul(P[index + 1], PublicKeyPoint(check.pubkey), r);
+        Q[index + 1] = check.Hm;
+    }
+
+    mcl::bn::Fp12 e;
+    mcl::bn::millerLoopVec(e, P.data(), Q.data(), P.size());
+    mcl::bn::finalExp(e, e);
+    return e.isOne();
+}
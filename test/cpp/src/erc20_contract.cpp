@@ -1,61 +1,65 @@
 #include "service_node_rewards/erc20_contract.hpp"
 
+#include "service_node_rewards/abi.hpp"
 #include "service_node_rewards/ec_utils.hpp"
 #include "ethyl/utils.hpp"
 
 // Function to call 'approve' method of ERC20 token contract
-ethyl::Transaction ERC20Contract::approve(const std::string& spender, uint64_t amount) {
+ethyl::Transaction ERC20Contract::approve(const std::string& spender, const Uint256& amount) {
     assert(contractAddress.size());
 
     ethyl::Transaction tx(contractAddress, 0, 3000000);
-    std::string functionSelector = ethyl::utils::toEthFunctionSignature("approve(address,uint256)");
-
-    std::string contractAddressOutput = spender;
-    if (contractAddressOutput.substr(0, 2) == "0x")
-        contractAddressOutput = contractAddressOutput.substr(2);  // remove "0x"
-    // Convert spender address and amount to appropriate format
-    std::string spender_padded = ethyl::utils::padTo32Bytes(contractAddressOutput, ethyl::utils::PaddingDirection::LEFT);
-    std::string amount_padded = ethyl::utils::padTo32Bytes(ethyl::utils::decimalToHex(amount), ethyl::utils::PaddingDirection::LEFT);
-
+    std::string_view functionSelector = APPROVE;
 
     // Construct the data payload for the transaction
-    tx.data = functionSelector + spender_padded + amount_padded;
+    AbiEncoder abi{functionSelector, 2};
+    abi.address(spender).uint(amount);
+    tx.data = std::move(abi).str();
     return tx;
 }
 
 // Function to call the 'transfer' method of an ERC20 token contract
-ethyl::Transaction ERC20Contract::transfer(const std::string& to, uint64_t amount) {
+ethyl::Transaction ERC20Contract::transfer(const std::string& to, const Uint256& amount) {
     assert(contractAddress.size());
     ethyl::Transaction tx(contractAddress, 0, 3000000);
-    std::string functionSelector = ethyl::utils::toEthFunctionSignature("transfer(address,uint256)");
-    
-    std::string formattedTo = to;
-    if (formattedTo.substr(0, 2) == "0x")
-        formattedTo = formattedTo.substr(2);  // remove "0x"
-    // Convert recipient address and amount to appropriate format
-    std::string to_padded = ethyl::utils::padTo32Bytes(formattedTo, ethyl::utils::PaddingDirection::LEFT);
-    std::string amount_padded = ethyl::utils::padTo32Bytes(ethyl::utils::decimalToHex(amount), ethyl::utils::PaddingDirection::LEFT);
-    
+    std::string_view functionSelector = TRANSFER;
+
     // Construct the data payload for the transaction
-    tx.data = functionSelector + to_padded + amount_padded;
+    AbiEncoder abi{functionSelector, 2};
+    abi.address(to).uint(amount);
+    tx.data = std::move(abi).str();
     return tx;
 }
 
 // Function to call 'balanceOf' method of ERC20 token contract
-uint64_t ERC20Contract::balanceOf(const std::string& address) {
+Uint256 ERC20Contract::balanceOf(const std::string& address) {
     assert(contractAddress.size());
 
-    std::string functionSelector = ethyl::utils::toEthFunctionSignature("balanceOf(address)");
+    std::string_view functionSelector = BALANCE_OF;
+    AbiEncoder  abi{functionSelector, 1};
+    abi.address(address);
+    std::string result = rpc->ethCall(contractAddress, abi.str());
+    return decodeBalanceOf(result);
+}
 
-    std::string addressOutput = address;
-    if (addressOutput.substr(0, 2) == "0x") {
-        addressOutput = addressOutput.substr(2);  // remove "0x" prefix if present
+std::vector<Uint256> ERC20Contract::balanceOf(JsonRpcBatch& batch, std::span<const std::string> addresses) {
+    assert(contractAddress.size());
+    assert(batch.size() == 0);
+
+    for (const std::string& address : addresses) {
+        AbiEncoder abi{BALANCE_OF, 1};
+        abi.address(address);
+        batch.ethCall(contractAddress, abi.str());
     }
-    std::string address_padded = ethyl::utils::padTo32Bytes(addressOutput, ethyl::utils::PaddingDirection::LEFT);
-    std::string result = provider.callReadFunction(contractAddress, functionSelector + address_padded);
 
-    // Parse the result into a uint64_t
-    // Assuming the result is returned as a 32-byte hexadecimal string that fits into uint64_t
-    return std::stoull(result.substr(2 + 64 - 16, 16), nullptr, 16);
+    std::vector<nlohmann::json> callResults = batch.execute();
+    std::vector<Uint256>        result;
+    result.reserve(callResults.size());
+    for (const nlohmann::json& callResult : callResults)
+        result.push_back(decodeBalanceOf(callResult.get_ref<const nlohmann::json::string_t&>()));
+    return result;
 }
 
+Uint256 ERC20Contract::decodeBalanceOf(std::string_view callResultHex) {
+    return AbiDecoder{callResultHex}.uint256(0);
+}
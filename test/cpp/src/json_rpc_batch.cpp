@@ -0,0 +1,125 @@
+#include "service_node_rewards/json_rpc_batch.hpp"
+
+#include <cpr/cpr.h>
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+JsonRpcBatch::JsonRpcBatch(std::string _url, size_t _maxBatchSize) : url(std::move(_url)), maxBatchSize(std::max<size_t>(_maxBatchSize, 1)) {
+}
+
+size_t JsonRpcBatch::request(std::string_view method, nlohmann::json params) {
+    size_t result = pending.size();
+    pending.push_back(nlohmann::json{
+            {"jsonrpc", "2.0"},
+            {"method", method},
+            {"params", std::move(params)},
+            {"id", nextID++},
+    });
+    return result;
+}
+
+size_t JsonRpcBatch::ethCall(std::string_view to, std::string_view data, std::string_view blockTag) {
+    return request("eth_call", nlohmann::json::array({{{"to", to}, {"data", data}}, blockTag}));
+}
+
+std::vector<nlohmann::json> JsonRpcBatch::execute() {
+    return send(nullptr);
+}
+
+std::vector<nlohmann::json> JsonRpcBatch::execute(std::vector<nlohmann::json>& errors) {
+    return send(&errors);
+}
+
+std::vector<nlohmann::json> JsonRpcBatch::send(std::vector<nlohmann::json>* errors) {
+    std::vector<nlohmann::json> requests = std::move(pending);
+    pending.clear();
+
+    std::vector<nlohmann::json> results(requests.size());
+    if (errors) {
+        errors->clear();
+        errors->resize(requests.size());
+    }
+
+    cpr::Session session;
+    session.SetUrl(cpr::Url{url});
+    session.SetHeader({{"Content-Type", "application/json"}});
+
+    for (size_t begin = 0; begin < requests.size(); begin += maxBatchSize) {
+        size_t end = std::min(begin + maxBatchSize, requests.size());
+
+        nlohmann::json batch = nlohmann::json::array();
+        for (size_t index = begin; index < end; index++)
+            batch.push_back(std::move(requests[index]));
+
+        uint64_t    firstID = batch.front()["id"].get<uint64_t>();
+        std::string body;
+        if (transport) {
+            body = transport(batch.dump());
+        } else {
+            session.SetBody(cpr::Body{batch.dump()});
+            cpr::Response response = session.Post();
+            if (response.error || response.status_code != 200) {
+                std::stringstream stream;
+                stream << "Failed to send JSON-RPC batch of " << batch.size() << " requests to '" << url << "': status " << response.status_code << ", " << response.error.message;
+                throw std::runtime_error(stream.str());
+            }
+            body = std::move(response.text);
+        }
+
+        std::span<nlohmann::json> batchErrors;
+        if (errors)
+            batchErrors = std::span(*errors).subspan(begin, end - begin);
+        parseResponse(body, firstID, std::span(results).subspan(begin, end - begin), batchErrors);
+    }
+
+    return results;
+}
+
+void JsonRpcBatch::parseResponse(std::string_view body, uint64_t firstID, std::span<nlohmann::json> results, std::span<nlohmann::json> errors) {
+    if (errors.size() && errors.size() != results.size()) {
+        std::stringstream stream;
+        stream << "JSON-RPC batch has " << results.size() << " results but " << errors.size() << " errors were given";
+        throw std::invalid_argument(stream.str());
+    }
+
+    nlohmann::json responses = nlohmann::json::parse(body);
+    if (!responses.is_array()) {
+        // NOTE: Nodes that reject a batch outright reply with a single error
+        std::stringstream stream;
+        stream << "JSON-RPC batch was rejected: " << responses.dump();
+        throw std::runtime_error(stream.str());
+    }
+
+    std::vector<bool> answered(results.size());
+    for (nlohmann::json& response : responses) {
+        uint64_t id = response.at("id").get<uint64_t>();
+        if (id < firstID || id - firstID >= results.size()) {
+            std::stringstream stream;
+            stream << "JSON-RPC batch returned a response with unexpected id " << id << ": " << response.dump();
+            throw std::runtime_error(stream.str());
+        }
+
+        size_t index = static_cast<size_t>(id - firstID);
+        if (auto error = response.find("error"); error != response.end()) {
+            if (errors.empty()) {
+                std::stringstream stream;
+                stream << "JSON-RPC request " << id << " in batch failed: " << error->dump();
+                throw std::runtime_error(stream.str());
+            }
+            errors[index]   = std::move(*error);
+            answered[index] = true;
+            continue;
+        }
+
+        results[index]  = std::move(response.at("result"));
+        answered[index] = true;
+    }
+
+    if (auto it = std::find(answered.begin(), answered.end(), false); it != answered.end()) {
+        std::stringstream stream;
+        stream << "JSON-RPC batch is missing the response for request " << firstID + static_cast<uint64_t>(it - answered.begin());
+        throw std::runtime_error(stream.str());
+    }
+}
@@ -0,0 +1,148 @@
+#include "service_node_rewards/liquidator.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <future>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include "ethyl/utils.hpp"
+
+Liquidator::Liquidator(ServiceNodeRewardsContract& _contract, OxendRpc& _oxend, TransactionPipeline* _pipeline, size_t maxConcurrentRequests)
+    : contract(_contract)
+    , oxend(_oxend)
+    , pipeline(_pipeline)
+    , requests(std::max<size_t>(maxConcurrentRequests, 1)) {
+}
+
+static const nlohmann::json& oxendResult(const nlohmann::json& response, std::string_view method) {
+    if (auto error = response.find("error"); error != response.end()) {
+        std::stringstream stream;
+        stream << "oxend request '" << method << "' failed: " << error->value("message", error->dump());
+        throw std::runtime_error(stream.str());
+    }
+    return response.at("result");
+}
+
+static std::string lowerHex(std::string_view hex) {
+    hex = ethyl::utils::trimPrefix(hex, "0x");
+    std::string result(hex);
+    std::transform(result.begin(), result.end(), result.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return result;
+}
+
+Liquidator::Round Liquidator::liquidate() {
+    Round round;
+    round.height = oxendResult(oxend.request("get_height"), "get_height").at("height").get<uint64_t>();
+    if (round.height <= lastHeight)
+        return round;
+    round.heightChanged = true;
+
+    // NOTE: Read the contract's node list whilst oxend assembles the
+    // liquidation list
+    std::future<ContractServiceNodeIDs> contractNodes = requests.submit([this]() { return contract.allServiceNodeIDs(); });
+    nlohmann::json                      list;
+    try {
+        list = oxendResult(oxend.request("bls_exit_liquidation_list"), "bls_exit_liquidation_list");
+    } catch (...) {
+        contractNodes.wait();
+        throw;
+    }
+
+    std::set<std::string> registered;
+    for (const bls::PublicKey& pubkey : contractNodes.get().pubkeys)
+        registered.insert(utils::BLSPublicKeyToHex(pubkey));
+
+    // NOTE: Forget submissions once their node has left the contract, or when
+    // they have been pending long enough that the transaction was likely dropped
+    const auto now = std::chrono::steady_clock::now();
+    std::erase_if(pending, [&](const auto& entry) { return !registered.contains(entry.first) || now - entry.second >= pendingTimeout; });
+
+    std::vector<std::future<Liquidation>> prepared;
+    round.candidates = list.size();
+    for (const nlohmann::json& entry : list) {
+        LiquidationCandidate candidate;
+        candidate.serviceNodePubkey = entry.at("service_node_pubkey").get<std::string>();
+        candidate.blsPubkey         = lowerHex(entry.at("info").at("bls_public_key").get<std::string>());
+        candidate.liquidationHeight = entry.at("liquidation_height").get<uint64_t>();
+        if (candidate.liquidationHeight > round.height || !registered.contains(candidate.blsPubkey) || pending.contains(candidate.blsPubkey)) {
+            round.skipped++;
+            continue;
+        }
+        prepared.push_back(requests.submit([this, candidate]() { return prepare(candidate); }));
+    }
+
+    // NOTE: Queue every liquidation that was signed and send them together
+    std::vector<std::pair<size_t, size_t>> submitted; // NOTE: Index into `liquidations` and into the pipeline's results
+    for (std::future<Liquidation>& future : prepared) {
+        Liquidation liquidation = future.get();
+        if (liquidation.error.empty() && pipeline) {
+            pending[liquidation.candidate.blsPubkey] = now;
+            submitted.emplace_back(round.liquidations.size(), pipeline->submit(liquidation.tx));
+        }
+        round.liquidations.push_back(std::move(liquidation));
+    }
+
+    if (pipeline && submitted.size()) {
+        std::vector<TransactionPipeline::Result> results = pipeline->wait(submitTimeout);
+        for (const auto& [liquidationIndex, resultIndex] : submitted) {
+            Liquidation& liquidation = round.liquidations[liquidationIndex];
+            liquidation.result       = std::move(results[resultIndex]);
+            if (liquidation.result.success)
+                continue;
+
+            liquidation.error = liquidation.result.error.empty() ? "Liquidation transaction reverted" : liquidation.result.error;
+
+            // NOTE: Only a transaction that was accepted but not yet mined can
+            // still liquidate the node, anything else is retried next round
+            if (liquidation.result.hash.empty() || !liquidation.result.receipt.is_null())
+                pending.erase(liquidation.candidate.blsPubkey);
+        }
+    }
+
+    lastHeight = round.height;
+    return round;
+}
+
+Liquidator::Liquidation Liquidator::prepare(const LiquidationCandidate& candidate) {
+    Liquidation result;
+    result.candidate = candidate;
+    try {
+        nlohmann::json        response  = oxend.request("bls_exit_liquidation_request", {{"pubkey", candidate.serviceNodePubkey}, {"liquidate", true}});
+        const nlohmann::json& signature = oxendResult(response, "bls_exit_liquidation_request");
+
+        std::string blsPubkey = lowerHex(signature.at("bls_pubkey").get<std::string>());
+        if (blsPubkey != candidate.blsPubkey) {
+            std::stringstream stream;
+            stream << "oxend signed the liquidation of BLS key " << blsPubkey << " instead of " << candidate.blsPubkey;
+            throw std::runtime_error(stream.str());
+        }
+
+        result.tx = contract.liquidateBLSPublicKeyWithSignature(
+                blsPubkey,
+                signature.at("timestamp").get<uint64_t>(),
+                signature.at("signature").get<std::string>(),
+                signature.at("non_signer_indices").get<std::vector<uint64_t>>());
+    } catch (const std::exception& e) {
+        result.error = e.what();
+    }
+    return result;
+}
+
+void Liquidator::run(std::chrono::milliseconds interval, const std::function<bool(const Round&)>& onRound) {
+    for (;;) {
+        const auto start = std::chrono::steady_clock::now();
+        Round      round;
+        try {
+            round = liquidate();
+        } catch (const std::exception& e) {
+            round.error = e.what();
+        }
+
+        if (!onRound(round))
+            return;
+        std::this_thread::sleep_until(start + interval);
+    }
+}
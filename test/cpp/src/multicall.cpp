@@ -0,0 +1,71 @@
+#include "service_node_rewards/multicall.hpp"
+#include "service_node_rewards/abi.hpp"
+#include "ethyl/utils.hpp"
+#include <nlohmann/json.hpp>
+
+#include <sstream>
+
+Multicall3::Multicall3(std::string _address) : address(std::move(_address)) {
+}
+
+size_t Multicall3::add(std::string_view target, std::string callData, bool allowFailure) {
+    size_t result = calls.size();
+    calls.push_back(Call{std::string(target), std::move(callData), allowFailure});
+    return result;
+}
+
+std::string Multicall3::encode() const {
+    // NOTE: Call3 is (address target, bool allowFailure, bytes callData), a
+    // dynamic tuple of 3 head words followed by the call data
+    const size_t CALL3_HEAD_WORDS = 3;
+
+    // NOTE: Size every element up front, the offsets of the elements in the
+    // array are relative to the first word after the array length
+    std::vector<size_t> elementWords;
+    elementWords.reserve(calls.size());
+    size_t totalWords = 1 /*offset*/ + 1 /*length*/ + calls.size() /*offsets*/;
+    for (const Call& call : calls) {
+        size_t callDataBytes = ethyl::utils::trimPrefix(call.callData, "0x").size() / 2;
+        elementWords.push_back(CALL3_HEAD_WORDS + AbiEncoder::bytesWords(callDataBytes));
+        totalWords += elementWords.back();
+    }
+
+    AbiEncoder abi{AGGREGATE3, totalWords};
+    abi.offset(1).uint(calls.size());
+
+    size_t elementOffset = calls.size();
+    for (size_t words : elementWords) {
+        abi.offset(elementOffset);
+        elementOffset += words;
+    }
+
+    for (const Call& call : calls)
+        abi.address(call.target).uint(call.allowFailure).offset(CALL3_HEAD_WORDS).bytesHex(call.callData);
+
+    return std::move(abi).str();
+}
+
+std::vector<Multicall3::Result> Multicall3::decode(std::string_view callResultHex) {
+    enum ResultWord : size_t {
+        Success,
+        ReturnDataOffset,
+    };
+
+    AbiDecoder array    = AbiDecoder{callResultHex}.tail(0);
+    uint64_t   count    = array.uint64(0);
+    AbiDecoder elements = array.slice(1);
+
+    std::vector<Result> results(count);
+    for (size_t index = 0; index < count; index++) {
+        AbiDecoder result         = elements.tail(index);
+        results[index].success    = result.uint64(Success) != 0;
+        results[index].returnData = result.bytesHex(ReturnDataOffset);
+    }
+    return results;
+}
+
+std::vector<Multicall3::Result> Multicall3::execute(RpcProvider& provider) {
+    std::string data = encode();
+    calls.clear();
+    return decode(provider.ethCall(address, data));
+}
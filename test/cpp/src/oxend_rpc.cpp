@@ -0,0 +1,104 @@
+#include "service_node_rewards/oxend_rpc.hpp"
+#include "service_node_rewards/uint256.hpp"
+
+#include <cpr/cpr.h>
+
+#include <sstream>
+#include <stdexcept>
+
+HttpOxendRpc::HttpOxendRpc(std::string _url, std::chrono::milliseconds _timeout) : url(std::move(_url)), timeout(_timeout) {
+}
+
+nlohmann::json HttpOxendRpc::request(std::string_view method, const nlohmann::json& params) {
+    nlohmann::json body = {
+            {"jsonrpc", "2.0"},
+            {"id", 0},
+            {"method", method},
+            {"params", params},
+    };
+
+    // NOTE: A session per request, requests are made concurrently
+    cpr::Session session;
+    session.SetUrl(cpr::Url{url + "/json_rpc"});
+    session.SetHeader({{"Content-Type", "application/json"}});
+    session.SetTimeout(cpr::Timeout{timeout});
+    session.SetBody(cpr::Body{body.dump()});
+    cpr::Response response = session.Post();
+    if (response.error || response.status_code != 200) {
+        std::stringstream stream;
+        stream << "Failed to send oxend request '" << method << "' to '" << url << "': status " << response.status_code << ", " << response.error.message;
+        throw std::runtime_error(stream.str());
+    }
+    return nlohmann::json::parse(response.text);
+}
+
+MockOxend::MockOxend(ServiceNodeList& _snl, uint32_t _chainID, std::string _contractAddress)
+    : snl(_snl)
+    , chainID(_chainID)
+    , contractAddress(std::move(_contractAddress)) {
+}
+
+std::string MockOxend::serviceNodePubkey(uint64_t serviceNodeID) {
+    return Uint256(serviceNodeID).toHex();
+}
+
+static nlohmann::json rpcError(int code, std::string_view message) {
+    return {{"jsonrpc", "2.0"}, {"id", 0}, {"error", {{"code", code}, {"message", message}}}};
+}
+
+static nlohmann::json rpcResult(nlohmann::json result) {
+    return {{"jsonrpc", "2.0"}, {"id", 0}, {"result", std::move(result)}};
+}
+
+nlohmann::json MockOxend::request(std::string_view method, const nlohmann::json& params) {
+    std::lock_guard<std::mutex> lock{mutex};
+    if (method == "get_height")
+        return rpcResult({{"height", height}});
+
+    if (method == "bls_exit_liquidation_list") {
+        nlohmann::json list = nlohmann::json::array();
+        for (const auto& [id, liquidationHeight] : liquidationHeights) {
+            int64_t index = snl.findNodeIndex(id);
+            if (index < 0)
+                continue;
+            list.push_back({
+                    {"service_node_pubkey", serviceNodePubkey(id)},
+                    {"liquidation_height", liquidationHeight},
+                    {"info", {{"bls_public_key", snl.nodes[static_cast<size_t>(index)].getPublicKeyHex()}}},
+            });
+        }
+        return rpcResult(std::move(list));
+    }
+
+    if (method == "bls_exit_liquidation_request") {
+        std::string pubkey    = params.value("pubkey", "");
+        bool        liquidate = params.value("liquidate", false);
+        uint64_t    id        = SERVICE_NODE_LIST_SENTINEL;
+        for (const auto& [candidate, liquidationHeight] : liquidationHeights) {
+            if (serviceNodePubkey(candidate) == pubkey)
+                id = candidate;
+        }
+
+        if (id == SERVICE_NODE_LIST_SENTINEL || snl.findNodeIndex(id) < 0)
+            return rpcError(-32602, "Service node " + pubkey + " is not in the exit or liquidation list");
+        if (liquidate && liquidationHeights.at(id) > height)
+            return rpcError(-32602, "Service node " + pubkey + " is not yet liquidatable");
+
+        std::vector<uint64_t> signers;
+        signers.reserve(snl.nodes.size());
+        for (const ServiceNode& node : snl.nodes) {
+            if (!liquidationHeights.contains(node.service_node_id))
+                signers.push_back(node.service_node_id);
+        }
+
+        auto [blsPubkey, signedTimestamp, signature] = snl.exitNodeFromIndices(id, chainID, contractAddress, signers, timestamp, liquidate);
+        return rpcResult({
+                {"bls_pubkey", blsPubkey},
+                {"timestamp", signedTimestamp},
+                {"signature", signature},
+                {"non_signer_indices", snl.findNonSigners(signers)},
+        });
+    }
+
+    return rpcError(-32601, "Method not found: " + std::string(method));
+}
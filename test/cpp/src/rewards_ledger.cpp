@@ -0,0 +1,110 @@
+#include "service_node_rewards/rewards_ledger.hpp"
+
+#include "ethyl/utils.hpp"
+#include <oxenc/hex.h>
+
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+#include <stdexcept>
+
+RewardsLedger::RewardsLedger(ServiceNodeList& _snl, ServiceNodeRewardsContract& _contract, uint32_t _chainID)
+    : snl(_snl)
+    , contract(_contract)
+    , chainID(_chainID) {
+}
+
+double RewardsLedger::Batch::recipientsPerSecond() const {
+    std::chrono::duration<double> elapsed = readDuration + signDuration;
+    return elapsed.count() > 0 ? static_cast<double>(recipients()) / elapsed.count() : 0;
+}
+
+static std::string normaliseAddress(std::string_view address) {
+    const size_t ADDRESS_HEX_SIZE = 20 * 2;
+    address                       = ethyl::utils::trimPrefix(address, "0x");
+    if (address.size() != ADDRESS_HEX_SIZE || !oxenc::is_hex(address)) {
+        std::stringstream stream;
+        stream << "Failed to parse recipient address '" << address << "': An address is " << ADDRESS_HEX_SIZE << " hex characters";
+        throw std::invalid_argument(stream.str());
+    }
+
+    std::string result(address);
+    std::transform(result.begin(), result.end(), result.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return result;
+}
+
+void RewardsLedger::accrue(std::string_view address, const Uint256& amount) {
+    balances[normaliseAddress(address)] += amount;
+}
+
+Uint256 RewardsLedger::accrued(std::string_view address) const {
+    auto it = balances.find(normaliseAddress(address));
+    return it == balances.end() ? Uint256{} : it->second;
+}
+
+RewardsLedger::Batch RewardsLedger::prepare(Multicall3& multicall, std::span<const uint64_t> signers) {
+    Batch result;
+
+    // NOTE: Read the contract's rewards of every recipient in chunks, a single
+    // aggregate3 of thousands of calls would exceed the node's gas limit
+    auto                     readStart = std::chrono::steady_clock::now();
+    std::vector<std::string> addresses;
+    addresses.reserve(balances.size());
+    for (const auto& [address, accrued] : balances)
+        addresses.push_back("0x" + address);
+
+    std::vector<Recipient> onChain;
+    onChain.reserve(addresses.size());
+    const size_t chunkSize = std::max<size_t>(readChunkSize, 1);
+    for (size_t begin = 0; begin < addresses.size(); begin += chunkSize) {
+        std::span<const std::string> chunk      = std::span<const std::string>(addresses).subspan(begin, std::min(chunkSize, addresses.size() - begin));
+        std::vector<Recipient>       recipients = contract.viewRecipientData(multicall, chunk);
+        onChain.insert(onChain.end(), recipients.begin(), recipients.end());
+    }
+
+    size_t index = 0;
+    for (const auto& [address, accrued] : balances) {
+        const Uint256& rewards = onChain[index].rewards;
+        if (accrued > rewards) {
+            Update update         = {};
+            update.address        = std::move(addresses[index]);
+            update.onChainRewards = rewards;
+            update.accruedRewards = accrued;
+            result.updates.push_back(std::move(update));
+        } else if (accrued == rewards) {
+            result.unchanged++;
+        } else {
+            result.behind.push_back(std::move(addresses[index]));
+        }
+        index++;
+    }
+    result.readDuration = std::chrono::steady_clock::now() - readStart;
+
+    // NOTE: The domain tags and non-signers are shared by every update, they're
+    // derived once here so the workers only read from `snl`
+    auto                        signStart  = std::chrono::steady_clock::now();
+    const DomainTags&           tags       = snl.domainTags(chainID, contract.contractAddress);
+    const std::vector<uint64_t> signerIDs  = {signers.begin(), signers.end()};
+    const std::vector<uint64_t> nonSigners = snl.findNonSigners(signerIDs);
+    auto                        signShard  = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            Update&     update    = result.updates[i];
+            std::string signature = snl.updateRewardsBalance(update.address, update.accruedRewards, tags, signerIDs);
+            update.tx             = contract.updateRewardsBalance(update.address, update.accruedRewards, signature, nonSigners);
+        }
+    };
+
+    // NOTE: A summed key signature is a single G2 multiplication so the
+    // updates are spread across the list's pool. The other modes already
+    // spread each signature across that pool, a task of the pool must not
+    // wait on the pool so the updates are signed one after another instead.
+    std::shared_ptr<WorkerPool> pool;
+    if (snl.signingMode == ServiceNodeList::SigningMode::AggregateSecretKey)
+        pool = snl.workerPool();
+    if (pool)
+        pool->forEachShard(result.updates.size(), signShard);
+    else
+        signShard(0, result.updates.size());
+    result.signDuration = std::chrono::steady_clock::now() - signStart;
+    return result;
+}
@@ -0,0 +1,85 @@
+#include "service_node_rewards/rpc_provider.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "ethyl/utils.hpp"
+
+std::string EthylRpcProvider::ethCall(std::string_view address, std::string_view data) {
+    nlohmann::json callResult = provider->callReadFunctionJSON(std::string(address), std::string(data));
+    if (!callResult.is_string()) {
+        std::stringstream stream;
+        stream << "eth_call to " << address << " did not return a hex result, response: " << callResult.dump();
+        throw std::runtime_error(stream.str());
+    }
+    return callResult.get<std::string>();
+}
+
+// NOTE: Calls are matched ignoring the 0x prefix and the case of the hex so
+// that checksummed and lower-cased addresses replay the same response
+static std::string normalise(std::string_view hex) {
+    hex = ethyl::utils::trimPrefix(hex, "0x");
+    std::string result(hex);
+    std::transform(result.begin(), result.end(), result.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return result;
+}
+
+ReplayRpcProvider ReplayRpcProvider::load(const std::filesystem::path& path) {
+    std::ifstream file{path};
+    if (!file) {
+        std::stringstream stream;
+        stream << "Failed to open RPC recording " << path;
+        throw std::runtime_error(stream.str());
+    }
+
+    nlohmann::json recording = nlohmann::json::parse(file, /*callback*/ nullptr, /*allow_exceptions*/ false);
+    if (!recording.is_array()) {
+        std::stringstream stream;
+        stream << "RPC recording " << path << " is not a JSON array of calls";
+        throw std::runtime_error(stream.str());
+    }
+
+    ReplayRpcProvider result;
+    for (const nlohmann::json& call : recording)
+        result.add(call.at("to").get<std::string>(), call.at("data").get<std::string>(), call.at("result").get<std::string>());
+    return result;
+}
+
+void ReplayRpcProvider::save(const std::filesystem::path& path) const {
+    nlohmann::json recording = nlohmann::json::array();
+    for (const auto& [key, call] : responses) {
+        for (const std::string& result : call.results)
+            recording.push_back({{"to", "0x" + key.first}, {"data", "0x" + key.second}, {"result", result}});
+    }
+
+    std::ofstream file{path, std::ios::trunc};
+    file << recording.dump(1) << '\n';
+    if (!file) {
+        std::stringstream stream;
+        stream << "Failed to write RPC recording " << path;
+        throw std::runtime_error(stream.str());
+    }
+}
+
+void ReplayRpcProvider::add(std::string_view address, std::string_view data, std::string result) {
+    responses[{normalise(address), normalise(data)}].results.push_back(std::move(result));
+}
+
+std::string ReplayRpcProvider::ethCall(std::string_view address, std::string_view data) {
+    if (upstream) {
+        std::string result = upstream->ethCall(address, data);
+        add(address, data, result);
+        return result;
+    }
+
+    auto it = responses.find({normalise(address), normalise(data)});
+    if (it == responses.end() || it->second.next >= it->second.results.size()) {
+        std::stringstream stream;
+        stream << "No recorded response remaining for eth_call to " << address << " with data " << data;
+        throw std::runtime_error(stream.str());
+    }
+    return it->second.results[it->second.next++];
+}
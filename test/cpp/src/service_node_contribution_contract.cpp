@@ -0,0 +1,185 @@
+#include "service_node_rewards/service_node_contribution_contract.hpp"
+#include "service_node_rewards/abi.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <sstream>
+#include <stdexcept>
+
+ethyl::Transaction ServiceNodeContributionContract::contributeFunds(const Uint256& amount, const std::string& beneficiary) {
+    ethyl::Transaction tx(contractAddress, 0, 3000000);
+    AbiEncoder         abi{CONTRIBUTE_FUNDS, 2};
+    abi.uint(amount).address(beneficiary);
+    tx.data = std::move(abi).str();
+    return tx;
+}
+
+ethyl::Transaction ServiceNodeContributionContract::finalize() {
+    ethyl::Transaction tx(contractAddress, 0, 3000000);
+    std::string_view functionSelector = FINALIZE;
+    tx.data = functionSelector;
+    return tx;
+}
+
+ethyl::Transaction ServiceNodeContributionContract::reset() {
+    ethyl::Transaction tx(contractAddress, 0, 3000000);
+    std::string_view functionSelector = RESET;
+    tx.data = functionSelector;
+    return tx;
+}
+
+ethyl::Transaction ServiceNodeContributionContract::withdrawContribution() {
+    ethyl::Transaction tx(contractAddress, 0, 3000000);
+    std::string_view functionSelector = WITHDRAW_CONTRIBUTION;
+    tx.data = functionSelector;
+    return tx;
+}
+
+ethyl::Transaction ServiceNodeContributionContract::resetUpdateAndContribute(const std::string& publicKey,
+                                                                             const std::string& sig,
+                                                                             const std::string& serviceNodePubkey,
+                                                                             const std::string& serviceNodeSignature,
+                                                                             uint16_t fee,
+                                                                             std::span<const ReservedContributor> reserved,
+                                                                             bool manualFinalize,
+                                                                             const std::string& beneficiary,
+                                                                             const Uint256& amount) {
+    ethyl::Transaction tx(contractAddress, 0, 3000000);
+
+    // 14 words before the reserved array: 2x pubkey, 4x sig, ed25519 pubkey,
+    // 2x ed25519 sig, fee, the pointer to the array, manual finalize,
+    // beneficiary and amount
+    const size_t HEAD_WORDS     = 14;
+    const size_t RESERVED_WORDS = 2;
+    AbiEncoder   abi{RESET_UPDATE_AND_CONTRIBUTE, HEAD_WORDS + 1 + reserved.size() * RESERVED_WORDS};
+    abi.words(publicKey)
+       .words(sig)
+       .leftPadded(std::span(reinterpret_cast<const uint8_t*>(serviceNodePubkey.data()), serviceNodePubkey.size()), 1)
+       .leftPadded(std::span(reinterpret_cast<const uint8_t*>(serviceNodeSignature.data()), serviceNodeSignature.size()), 2)
+       .uint(fee)
+       .offset(HEAD_WORDS)
+       .uint(manualFinalize)
+       .address(beneficiary)
+       .uint(amount)
+       .uint(reserved.size());
+    for (const ReservedContributor& contributor : reserved)
+        abi.address(contributor.address).uint(contributor.amount);
+
+    tx.data = std::move(abi).str();
+    return tx;
+}
+
+std::vector<Contributor> ServiceNodeContributionContract::getContributions() {
+    return decodeContributions(rpc->ethCall(contractAddress, GET_CONTRIBUTIONS));
+}
+
+std::vector<std::vector<Contributor>> ServiceNodeContributionContract::getContributions(Multicall3& multicall, std::span<const std::string> contractAddresses) {
+    assert(multicall.size() == 0);
+    for (const std::string& address : contractAddresses)
+        multicall.add(address, std::string(GET_CONTRIBUTIONS.view()));
+
+    std::vector<Multicall3::Result>       callResults = multicall.execute(*rpc);
+    std::vector<std::vector<Contributor>> result;
+    result.reserve(callResults.size());
+    for (const Multicall3::Result& callResult : callResults)
+        result.push_back(decodeContributions(callResult.returnData));
+    return result;
+}
+
+std::vector<ReservedContribution> ServiceNodeContributionContract::getReserved() {
+    return decodeReserved(rpc->ethCall(contractAddress, GET_RESERVED));
+}
+
+std::string ServiceNodeContributionContract::blsSignature() {
+    std::string callResultHex = rpc->ethCall(contractAddress, BLS_SIGNATURE);
+    return std::string(AbiDecoder{callResultHex}.wordsHex(0, 4));
+}
+
+ServiceNodeParams ServiceNodeContributionContract::serviceNodeParams() {
+    return decodeServiceNodeParams(rpc->ethCall(contractAddress, SERVICE_NODE_PARAMS));
+}
+
+ServiceNodeContributionContract::Status ServiceNodeContributionContract::status() {
+    std::string callResultHex = rpc->ethCall(contractAddress, STATUS);
+    uint64_t    result        = AbiDecoder{callResultHex}.uint64(0);
+    if (result > static_cast<uint64_t>(Status::Finalized)) {
+        std::stringstream stream;
+        stream << "Failed to decode status, " << result << " is not a contribution contract status";
+        throw std::runtime_error(stream.str());
+    }
+    return static_cast<Status>(result);
+}
+
+// NOTE: The list views return parallel arrays, they must all be the length of
+// the first array
+static uint64_t arrayLength(std::string_view function, std::span<const AbiDecoder> arrays) {
+    const uint64_t result = arrays[0].uint64(0);
+    for (const AbiDecoder& array : arrays) {
+        if (array.uint64(0) != result) {
+            std::stringstream stream;
+            stream << "Failed to decode " << function << ", returned arrays of " << result << " and " << array.uint64(0) << " elements";
+            throw std::runtime_error(stream.str());
+        }
+    }
+    return result;
+}
+
+std::vector<Contributor> ServiceNodeContributionContract::decodeContributions(std::string_view callResultHex) {
+    // NOTE: (address[] addrs, address[] beneficiaries, uint256[] contribs)
+    AbiDecoder       result = AbiDecoder{callResultHex};
+    const AbiDecoder arrays[] = {result.tail(0), result.tail(1), result.tail(2)};
+    const auto& [addresses, beneficiaries, amounts] = arrays;
+    const uint64_t count = arrayLength("getContributions", arrays);
+
+    std::vector<Contributor> contributors(count);
+    for (size_t i = 0; i < count; i++) {
+        Contributor& c       = contributors[i];
+        c.address            = addresses.address(1 + i);
+        c.beneficiaryAddress = beneficiaries.address(1 + i);
+        c.amount             = amounts.uint256(1 + i);
+    }
+    return contributors;
+}
+
+std::vector<ReservedContribution> ServiceNodeContributionContract::decodeReserved(std::string_view callResultHex) {
+    // NOTE: (address[] addrs, uint256[] contribs, bool[] received)
+    AbiDecoder       result = AbiDecoder{callResultHex};
+    const AbiDecoder arrays[] = {result.tail(0), result.tail(1), result.tail(2)};
+    const auto& [addresses, amounts, received] = arrays;
+    const uint64_t count = arrayLength("getReserved", arrays);
+
+    std::vector<ReservedContribution> reserved(count);
+    for (size_t i = 0; i < count; i++) {
+        ReservedContribution& r = reserved[i];
+        r.address               = addresses.address(1 + i);
+        r.amount                = amounts.uint256(1 + i);
+        r.received              = received.uint64(1 + i) != 0;
+    }
+    return reserved;
+}
+
+ServiceNodeParams ServiceNodeContributionContract::decodeServiceNodeParams(std::string_view callResultHex) {
+    enum ServiceNodeParamsWord : size_t {
+        Ed25519Pubkey,
+        Ed25519Signature1,
+        Ed25519Signature2,
+        Fee,
+    };
+
+    AbiDecoder              abi{callResultHex};
+    std::array<uint8_t, 32> signature1 = abi.bytes32(Ed25519Signature1);
+    std::array<uint8_t, 32> signature2 = abi.bytes32(Ed25519Signature2);
+    uint64_t                fee        = abi.uint64(Fee);
+    if (fee > UINT16_MAX) {
+        std::stringstream stream;
+        stream << "Failed to decode serviceNodeParams, fee " << fee << " does not fit a uint16";
+        throw std::runtime_error(stream.str());
+    }
+
+    ServiceNodeParams result = {};
+    result.ed25519Pubkey     = abi.bytes32(Ed25519Pubkey);
+    std::copy(signature1.begin(), signature1.end(), result.ed25519Signature.begin());
+    std::copy(signature2.begin(), signature2.end(), result.ed25519Signature.begin() + signature1.size());
+    result.fee = static_cast<uint16_t>(fee);
+    return result;
+}
@@ -7,12 +7,12 @@ extern "C" {
 #include "crypto/keccak.h"
 }
 
-#include <mcl/gmp_util.hpp>
-
 #include <algorithm>
+#include <cctype>
 #include <chrono>
 #include <random>
 #include <cstring>
+#include <sstream>
 
 const std::string proofOfPossessionTag = "BLS_SIG_TRYANDINCREMENT_POP";
 const std::string rewardTag = "BLS_SIG_TRYANDINCREMENT_REWARD";
@@ -20,79 +20,170 @@ const std::string exitTag = "BLS_SIG_TRYANDINCREMENT_EXIT";
 const std::string liquidateTag = "BLS_SIG_TRYANDINCREMENT_LIQUIDATE";
 const std::string hashToG2Tag = "BLS_SIG_HASH_TO_FIELD_TAG";
 
-ServiceNode::ServiceNode(uint64_t _service_node_id) {
-    service_node_id = _service_node_id;
-    // This init function generates a secret key calling blsSecretKeySetByCSPRNG
-    secretKey.init();
+// NOTE: Bits `bit` to `bit + width` of the little-endian integer in `block`,
+// the window may straddle two units
+static uint64_t scalarWindow(const mcl::fp::Block& block, size_t bit, size_t width) {
+    const size_t UNIT_BITS = sizeof(mcl::fp::Unit) * 8;
+    const size_t unit      = bit / UNIT_BITS;
+    const size_t shift     = bit % UNIT_BITS;
+    if (unit >= block.n)
+        return 0;
+
+    uint64_t result = static_cast<uint64_t>(block.p[unit]) >> shift;
+    if (shift + width > UNIT_BITS && unit + 1 < block.n)
+        result |= static_cast<uint64_t>(block.p[unit + 1]) << (UNIT_BITS - shift);
+    return result & ((uint64_t{1} << width) - 1);
 }
 
-static std::string buildTag(const std::string& baseTag, uint32_t chainID, std::string_view contractAddress) {
-    // Check if contractAddress starts with "0x" prefix
-    std::string contractAddressOutput = std::string(contractAddress);
-    if (contractAddressOutput.substr(0, 2) == "0x")
-        contractAddressOutput = contractAddressOutput.substr(2);  // remove "0x"
-    std::string concatenatedTag = "0x" + oxenc::to_hex(baseTag) + ethyl::utils::padTo32Bytes(ethyl::utils::decimalToHex(chainID), ethyl::utils::PaddingDirection::LEFT) + contractAddressOutput;
-    auto hashed_tag = ethyl::utils::hashHex(concatenatedTag);
-    return oxenc::to_hex(hashed_tag.begin(), hashed_tag.end());
+template <typename Point>
+FixedBaseTable<Point>::FixedBaseTable(const Point& base, size_t _windowBits) : bits(_windowBits) {
+    if (bits < MIN_WINDOW_BITS || bits > MAX_WINDOW_BITS) {
+        std::stringstream stream;
+        stream << "Failed to build fixed-base table, window of " << bits << " bits is outside of [" << MIN_WINDOW_BITS << ", " << MAX_WINDOW_BITS << "]";
+        throw std::invalid_argument(stream.str());
+    }
+
+    // NOTE: Row `i` holds 1..digits multiples of `2^(bits * i) * base`, the
+    // next row's base is `digits + 1` times the current one
+    const size_t digits = (size_t{1} << bits) - 1;
+    windows             = (mcl::bn::Fr::getBitSize() + bits - 1) / bits;
+    points.resize(windows * digits);
+    Point rowBase = base;
+    for (size_t window = 0; window < windows; window++) {
+        Point* row = points.data() + window * digits;
+        row[0]     = rowBase;
+        for (size_t digit = 1; digit < digits; digit++)
+            Point::add(row[digit], row[digit - 1], rowBase);
+        Point::add(rowBase, row[digits - 1], rowBase);
+    }
+
+    // NOTE: Adding a normalised (z = 1) point takes mcl's cheaper mixed
+    // addition. Normalising in batches shares one field inversion per batch
+    // whilst bounding the scratch space mcl allocates on the stack.
+    const size_t BATCH = 256;
+    for (size_t begin = 0; begin < points.size(); begin += BATCH) {
+        const size_t count = std::min(BATCH, points.size() - begin);
+        Point::normalizeVec(points.data() + begin, points.data() + begin, count);
+    }
 }
 
-static mcl::bn::G2 mapToG2(std::span<const uint8_t> msg, std::span<const uint8_t> hashToG2Tag) {
+template <typename Point>
+Point FixedBaseTable<Point>::mul(const mcl::bn::Fr& scalar) const {
+    // NOTE: Fr is stored in Montgomery form, `getBlock` converts it back into
+    // the integer whose windows index the table
+    mcl::fp::Block block;
+    scalar.getBlock(block);
 
-    mcl::bn::G2 result = {};
+    const size_t digits = (size_t{1} << bits) - 1;
+    Point        result;
     result.clear();
+    for (size_t window = 0; window < windows; window++) {
+        const uint64_t digit = scalarWindow(block, window * bits, bits);
+        if (digit)
+            Point::add(result, result, points[window * digits + static_cast<size_t>(digit) - 1]);
+    }
+    return result;
+}
 
-    std::vector<uint8_t> messageWithI(msg.size() + 1);
-    std::memcpy(messageWithI.data(), msg.data(), msg.size());
+template <typename Point>
+size_t FixedBaseTable<Point>::optimalWindowBits(size_t multiplications) {
+    size_t result   = MIN_WINDOW_BITS;
+    double bestCost = 0;
+    for (size_t windowBits = MIN_WINDOW_BITS; windowBits <= MAX_WINDOW_BITS; windowBits++) {
+        const double windowCount = static_cast<double>((mcl::bn::Fr::getBitSize() + windowBits - 1) / windowBits);
+        const double buildCost   = windowCount * static_cast<double>((size_t{1} << windowBits) - 1);
+        const double cost        = buildCost + windowCount * static_cast<double>(multiplications);
+        if (windowBits == MIN_WINDOW_BITS || cost < bestCost) {
+            result   = windowBits;
+            bestCost = cost;
+        }
+    }
+    return result;
+}
 
-    // NOTE: The field modulus from Solidity BN256G2 in little endian
-    // format.
-    static const uint8_t FIELD_MODULUS_BYTES_LE[] = {
-        0x47, 0xfd, 0x7c, 0xd8, 0x16, 0x8c, 0x20, 0x3c, 0x8d,
-        0xca, 0x71, 0x68, 0x91, 0x6a, 0x81, 0x97, 0x5d, 0x58,
-        0x81, 0x81, 0xb6, 0x45, 0x50, 0xb8, 0x29, 0xa0, 0x31,
-        0xe1, 0x72, 0x4e, 0x64, 0x30,
-    };
+template class FixedBaseTable<mcl::bn::G1>;
+template class FixedBaseTable<mcl::bn::G2>;
 
-    mcl::Vint fieldModulus = {};
-    fieldModulus.setArray(FIELD_MODULUS_BYTES_LE, sizeof(FIELD_MODULUS_BYTES_LE));
+ServiceNode::ServiceNode() {
+    secretKey.clear();
+    publicKey.clear();
+}
 
-    for (uint8_t increment = 0;; increment++) {
-        messageWithI[messageWithI.size() - 1] = increment;
+ServiceNode::ServiceNode(uint64_t _service_node_id) {
+    service_node_id = _service_node_id;
+    // This init function generates a secret key calling blsSecretKeySetByCSPRNG
+    secretKey.init();
+    secretKey.getPublicKey(publicKey);
+}
 
-        // NOTE: Solidity's BN256G2.hashToField(msg, tag) => x1, x2, b
-        mcl::bn::Fp x1 = {}, x2 = {};
-        bool b = {};
-        {
-            uint8_t expandedBytes[128] = {};
-            utils::ExpandMessageXMDKeccak256(expandedBytes, messageWithI, hashToG2Tag);
+ServiceNode::ServiceNode(uint64_t _service_node_id, const G1FixedBaseTable& generatorTable) {
+    service_node_id = _service_node_id;
+    secretKey.init();
 
-            bool converted;
-            x1.setBigEndianMod(&converted, expandedBytes + 0,  48);
-            assert(converted);
-            x2.setBigEndianMod(&converted, expandedBytes + 48, 48);
-            assert(converted);
+    // NOTE: const_cast is legal because `publicKey` is not declared const
+    mcl::bn::G1* point = reinterpret_cast<mcl::bn::G1*>(&const_cast<blsPublicKey*>(publicKey.getPtr())->v);
+    *point             = generatorTable.mul(getSecretScalar());
+    static_assert(sizeof(*point) == sizeof(publicKey.getPtr()->v));
+}
 
-            b = ((expandedBytes[127] & 1) == 1);
-        }
+uint8_t* MessageBuilder::reserve(size_t count) {
+    if (count > CAPACITY - size) {
+        std::stringstream stream;
+        stream << "Failed to append " << count << " bytes to message of " << size << " bytes, the message would exceed the capacity of " << CAPACITY << " bytes";
+        throw std::runtime_error(stream.str());
+    }
+    uint8_t* result = buffer.data() + size;
+    size += count;
+    return result;
+}
 
-        // NOTE: herumi/bls MapTo::mapToEC
-        mcl::bn::G2::Fp x = mcl::bn::G2::Fp(x1, x2);
-        mcl::bn::G2::Fp y;
-        mcl::bn::G2::getWeierstrass(y, x);
-        if (mcl::bn::G2::Fp::squareRoot(y, y)) { // Check if this is a point
-            if (b)                               // Let b => {0, 1} to choose between the two roots.
-                y = -y;
-            bool converted;
-            result.set(&converted, x, y, false);
-            assert(converted);
-            return result;                       // Successfully mapped to curve, exit the loop
-        }
+MessageBuilder& MessageBuilder::append(std::span<const uint8_t> data) {
+    std::memcpy(reserve(data.size()), data.data(), data.size());
+    return *this;
+}
+
+MessageBuilder& MessageBuilder::appendLeftPadded(std::span<const uint8_t> data, size_t width) {
+    if (data.size() > width) {
+        std::stringstream stream;
+        stream << "Failed to pad " << data.size() << " bytes to a width of " << width << " bytes";
+        throw std::runtime_error(stream.str());
     }
+    uint8_t* dst = reserve(width);
+    std::memset(dst, 0, width - data.size());
+    std::memcpy(dst + (width - data.size()), data.data(), data.size());
+    return *this;
+}
 
-    return result;
+MessageBuilder& MessageBuilder::appendAddress(std::string_view hex) {
+    const size_t ADDRESS_SIZE = 20;
+    hex                       = ethyl::utils::trimPrefix(hex, "0x");
+    if (hex.size() > ADDRESS_SIZE * 2 || !oxenc::is_hex(hex)) {
+        std::stringstream stream;
+        stream << "Failed to append address '" << hex << "': An address is at most " << ADDRESS_SIZE * 2 << " hex characters";
+        throw std::runtime_error(stream.str());
+    }
+    uint8_t* dst     = reserve(ADDRESS_SIZE);
+    size_t   padding = ADDRESS_SIZE - hex.size() / 2;
+    std::memset(dst, 0, padding);
+    oxenc::from_hex(hex.begin(), hex.end(), dst + padding);
+    return *this;
 }
 
-bls::Signature ServiceNode::blsSignHash(std::span<const uint8_t> msg, uint32_t chainID, std::string_view contractAddress) const {
+MessageBuilder& MessageBuilder::appendU256(const Uint256& value) {
+    std::array<uint8_t, 32> bytes = value.toBigEndian();
+    std::memcpy(reserve(bytes.size()), bytes.data(), bytes.size());
+    return *this;
+}
+
+DomainTags::DomainTags(uint32_t chainID, std::string_view contractAddress) :
+    proofOfPossession(utils::BuildTag(proofOfPossessionTag, chainID, contractAddress)),
+    reward(utils::BuildTag(rewardTag, chainID, contractAddress)),
+    exit(utils::BuildTag(exitTag, chainID, contractAddress)),
+    liquidate(utils::BuildTag(liquidateTag, chainID, contractAddress)),
+    hashToG2(utils::BuildTag(hashToG2Tag, chainID, contractAddress)) {
+}
+
+PreparedMessage PreparedMessage::prepare(std::span<const uint8_t> msg, const DomainTags& tags) {
     // NOTE: This is herumi's 'blsSignHash' deconstructed to its primitive
     // function calls but instead of executing herumi's 'tryAndIncMapTo' which
     // maps a hash to a point we execute our own mapping function. herumi's
@@ -106,71 +197,119 @@ bls::Signature ServiceNode::blsSignHash(std::span<const uint8_t> msg, uint32_t c
 
     // NOTE: mcl::bn::blsSignHash(...) -> toG(...)
     // Map a string of `bytes` to a point on the curve for BLS
-    mcl::bn::G2 Hm;
-    {
-        std::string hashToG2TagHex       = buildTag(hashToG2Tag, chainID, contractAddress);
-        std::vector<uint8_t> hashToG2Tag = ethyl::utils::fromHexString<uint8_t>(hashToG2TagHex);
-        Hm                               = mapToG2(msg, hashToG2Tag);
-        mcl::bn::BN::param.mapTo.mulByCofactor(Hm);
-    }
+    PreparedMessage result;
+    result.Hm = utils::HashToG2(msg, tags.hashToG2);
+    return result;
+}
 
-    // NOTE: mcl::bn::blsSignHash(...) -> GmulCT(...) -> G2::mulCT
+PreparedMessage PreparedMessage::prepare(std::span<const uint8_t> msg, uint32_t chainID, std::string_view contractAddress) {
+    PreparedMessage result;
+    result.Hm = utils::HashToG2(msg, utils::BuildTag(hashToG2Tag, chainID, contractAddress));
+    return result;
+}
+
+PreparedMessage& PreparedMessage::precompute(size_t signers) {
+    table = std::make_shared<const G2FixedBaseTable>(Hm, G2FixedBaseTable::optimalWindowBits(signers));
+    return *this;
+}
+
+bls::Signature ServiceNode::blsSignHash(std::span<const uint8_t> msg, const DomainTags& tags) const {
+    return signPrepared(PreparedMessage::prepare(msg, tags));
+}
+
+bls::Signature ServiceNode::blsSignHash(std::span<const uint8_t> msg, uint32_t chainID, std::string_view contractAddress) const {
+    return signPrepared(PreparedMessage::prepare(msg, chainID, contractAddress));
+}
+
+static bls::Signature mulHm(const PreparedMessage& message, const mcl::bn::Fr& s) {
     bls::Signature result = {};
     result.clear();
-    {
-        mcl::bn::Fr s;
-        std::memcpy(const_cast<uint64_t*>(s.getUnit()), &secretKey.getPtr()->v, sizeof(s));
-        static_assert(sizeof(s) == sizeof(secretKey.getPtr()->v));
-
-        mcl::bn::G2 g2;
-        mcl::bn::G2::mulCT(g2, Hm, s);
-        std::memcpy(&result.getPtr()->v.x, &g2.x, sizeof(g2.x));
-        std::memcpy(&result.getPtr()->v.y, &g2.y, sizeof(g2.y));
-        std::memcpy(&result.getPtr()->v.z, &g2.z, sizeof(g2.z));
-        static_assert(sizeof(g2) == sizeof(result.getPtr()->v));
-    }
 
+    // NOTE: mcl::bn::blsSignHash(...) -> GmulCT(...) -> G2::mulCT
+    mcl::bn::G2 g2;
+    if (message.table)
+        g2 = message.table->mul(s);
+    else
+        mcl::bn::G2::mulCT(g2, message.Hm, s);
+    std::memcpy(&result.getPtr()->v.x, &g2.x, sizeof(g2.x));
+    std::memcpy(&result.getPtr()->v.y, &g2.y, sizeof(g2.y));
+    std::memcpy(&result.getPtr()->v.z, &g2.z, sizeof(g2.z));
+    static_assert(sizeof(g2) == sizeof(result.getPtr()->v));
     return result;
 }
 
-// TODO(doyle): oxen-core has a new BLS implementation that can construct these
-// messages directly as a byte stream and avoid the marshalling back-and-forth.
-//
-// For now we construct the hex strings then marshall to bytes for the BLS
-// operations.
-//
-// In particular BLSSigner can be pulled into this repository as a utility class
-// that can then be imported by oxen-core for use in the core-repo. This repo
-// should contain all the contracts and bindings code (like BLSSigner) that help
-// end-user applications like oxen-core interact with the contracts (such as
-// creating a proof-of-posession).
-//
-// It will also allow this test repository to re-use that functionality for
-// testing purposes.
+bls::Signature ServiceNode::signPrepared(const PreparedMessage& message) const {
+    return mulHm(message, getSecretScalar());
+}
+
+mcl::bn::Fr ServiceNode::getSecretScalar() const {
+    mcl::bn::Fr s;
+    std::memcpy(const_cast<uint64_t*>(s.getUnit()), &secretKey.getPtr()->v, sizeof(s));
+    static_assert(sizeof(s) == sizeof(secretKey.getPtr()->v));
+    return s;
+}
+
+// NOTE: `tag` is the proof of possession domain tag of the chain and contract
+static MessageBuilder proofOfPossessionMessage(std::span<const uint8_t> tag, const bls::PublicKey& publicKey, const std::string& senderEthAddress, const std::string& serviceNodePubkey) {
+    MessageBuilder message;
+    message.append(tag)
+            .append(utils::BLSPublicKeyToBytes(publicKey))
+            .appendAddress(senderEthAddress)
+            .appendLeftPadded(std::span(reinterpret_cast<const uint8_t*>(serviceNodePubkey.data()), serviceNodePubkey.size()), 32);
+    return message;
+}
+
+std::string ServiceNode::proofOfPossession(const DomainTags& tags, const std::string& senderEthAddress, const std::string& serviceNodePubkey) {
+    MessageBuilder message = proofOfPossessionMessage(tags.proofOfPossession, publicKey, senderEthAddress, serviceNodePubkey);
+    bls::Signature sig     = blsSignHash(message.bytes(), tags);
+    return utils::SignatureToHex(sig);
+}
+
 std::string ServiceNode::proofOfPossession(uint32_t chainID, const std::string& contractAddress, const std::string& senderEthAddress, const std::string& serviceNodePubkey) {
-    std::string senderAddressOutput = senderEthAddress;
-    if (senderAddressOutput.substr(0, 2) == "0x")
-        senderAddressOutput = senderAddressOutput.substr(2);  // remove "0x"
-    std::string fullTag               = buildTag(proofOfPossessionTag, chainID, contractAddress);
-    std::string message               = "0x" + fullTag + getPublicKeyHex() + senderAddressOutput + ethyl::utils::padTo32Bytes(oxenc::to_hex(serviceNodePubkey), ethyl::utils::PaddingDirection::LEFT);
-    std::vector<uint8_t> messageBytes = ethyl::utils::fromHexString<uint8_t>(message);
-    bls::Signature sig                = blsSignHash(messageBytes, chainID, contractAddress);
+    // NOTE: Derive only the 2 tags used (proof of possession and hash to G2)
+    // rather than every tag of a `DomainTags`
+    const std::array<uint8_t, 32> tag     = utils::BuildTag(proofOfPossessionTag, chainID, contractAddress);
+    MessageBuilder                message = proofOfPossessionMessage(tag, publicKey, senderEthAddress, serviceNodePubkey);
+    bls::Signature                sig     = blsSignHash(message.bytes(), chainID, contractAddress);
     return utils::SignatureToHex(sig);
 }
 
 std::string ServiceNode::getPublicKeyHex() const {
-    bls::PublicKey publicKey;
-    secretKey.getPublicKey(publicKey);
     return utils::BLSPublicKeyToHex(publicKey);
 }
 
-bls::PublicKey ServiceNode::getPublicKey() const {
-    bls::PublicKey publicKey;
-    secretKey.getPublicKey(publicKey);
+const bls::PublicKey& ServiceNode::getPublicKey() const {
     return publicKey;
 }
 
-ServiceNodeList::ServiceNodeList(size_t numNodes) {
+SignerSet::SignerSet(std::span<const uint64_t> serviceNodeIDs) {
+    for (uint64_t id : serviceNodeIDs)
+        insert(id);
+}
+
+void SignerSet::insert(uint64_t serviceNodeID) {
+    const size_t word = static_cast<size_t>(serviceNodeID / 64);
+    if (word >= words.size())
+        words.resize(word + 1);
+    words[word] |= uint64_t{1} << (serviceNodeID % 64);
+}
+
+bool SignerSet::contains(uint64_t serviceNodeID) const {
+    const size_t word = static_cast<size_t>(serviceNodeID / 64);
+    return word < words.size() && (words[word] >> (serviceNodeID % 64)) & 1;
+}
+
+// NOTE: bls::PublicKey only exposes addition, subtraction is done on the
+// underlying G1 point.
+static void subPublicKey(bls::PublicKey& lhs, const bls::PublicKey& rhs) {
+    // NOTE: const_cast is legal because the original object was not declared
+    // const
+    mcl::bn::G1*       lhsPoint = reinterpret_cast<mcl::bn::G1*>(&const_cast<blsPublicKey*>(lhs.getPtr())->v);
+    const mcl::bn::G1* rhsPoint = reinterpret_cast<const mcl::bn::G1*>(&rhs.getPtr()->v);
+    mcl::bn::G1::sub(*lhsPoint, *lhsPoint, *rhsPoint);
+}
+
+ServiceNodeList::ServiceNodeList(size_t numNodes, size_t _signingThreads) : signingThreads(_signingThreads) {
     bls::init(mclBn_CurveSNARK1);
     mclBn_setMapToMode(MCL_MAP_TO_MODE_TRY_AND_INC);
     mcl::bn::G1 gen;
@@ -180,78 +319,190 @@ ServiceNodeList::ServiceNodeList(size_t numNodes) {
     publicKey.v = *reinterpret_cast<const mclBnG1*>(&gen); // Cast gen to mclBnG1 and assign it to publicKey.v
 
     blsSetGeneratorOfPublicKey(&publicKey);
+    if (numNodes >= GENERATOR_TABLE_MIN_NODES)
+        generatorTable = std::make_shared<const G1FixedBaseTable>(gen, G1FixedBaseTable::optimalWindowBits(numNodes));
+    aggregatePubkey.clear();
+    links[SERVICE_NODE_LIST_SENTINEL] = {};
     nodes.reserve(numNodes);
-    for(size_t i = 0; i < numNodes; ++i) {
-        nodes.emplace_back(next_service_node_id); // construct new ServiceNode in-place
-        next_service_node_id++;
-    }
+    nodeIndices.reserve(numNodes);
+    for(size_t i = 0; i < numNodes; ++i)
+        addNode();
 }
 
 ServiceNodeList::~ServiceNodeList() {
 }
 
 void ServiceNodeList::addNode() {
-    nodes.emplace_back(next_service_node_id); // construct new ServiceNode in-plac
-    next_service_node_id++;
+    const uint64_t     id   = next_service_node_id++;
+    const ServiceNode& node = generatorTable ? nodes.emplace_back(id, *generatorTable) : nodes.emplace_back(id); // construct new ServiceNode in-place
+    nodeIndices[id]         = nodes.size() - 1;
+    aggregatePubkey.add(node.getPublicKey());
+
+    // NOTE: Append to the tail of the linked list, see `serviceNodeAdd` in
+    // ServiceNodeRewards.sol
+    ServiceNodeLinks& sentinel = links[SERVICE_NODE_LIST_SENTINEL];
+    const uint64_t    prev     = sentinel.prev;
+    links[id]                  = ServiceNodeLinks{SERVICE_NODE_LIST_SENTINEL, prev};
+    links[prev].next           = id;
+    sentinel.prev              = id;
 }
 
 void ServiceNodeList::deleteNode(uint64_t serviceNodeID) {
-    auto it = std::find_if(nodes.begin(), nodes.end(), 
-                           [serviceNodeID](const ServiceNode& node) {
-                               return node.service_node_id == serviceNodeID;
-                           });
-
-    if (it != nodes.end()) {
-        nodes.erase(it);
+    auto it = nodeIndices.find(serviceNodeID);
+    if (it == nodeIndices.end() || serviceNodeID == SERVICE_NODE_LIST_SENTINEL)
+        return;
+
+    // NOTE: Unlink from the linked list, see `serviceNodeDelete` in
+    // ServiceNodeRewards.sol
+    const ServiceNodeLinks nodeLinks = links[serviceNodeID];
+    links[nodeLinks.next].prev       = nodeLinks.prev;
+    links[nodeLinks.prev].next       = nodeLinks.next;
+    links.erase(serviceNodeID);
+
+    // NOTE: Swap-remove the node from storage and patch the index of the node
+    // that was moved into its slot
+    const size_t index = it->second;
+    nodeIndices.erase(it);
+    subPublicKey(aggregatePubkey, nodes[index].getPublicKey());
+    if (index != nodes.size() - 1) {
+        nodes[index]                              = std::move(nodes.back());
+        nodeIndices[nodes[index].service_node_id] = index;
     }
-    // Optionally, you can handle the case where the node is not found
+    nodes.pop_back();
 }
 
 std::string ServiceNodeList::getLatestNodePubkey() {
-    return nodes.back().getPublicKeyHex();
+    const uint64_t tail = prevServiceNodeID(SERVICE_NODE_LIST_SENTINEL);
+    return nodes[nodeIndex(tail)].getPublicKeyHex();
+}
+
+uint64_t ServiceNodeList::nextServiceNodeID(uint64_t service_node_id) const {
+    auto it = links.find(service_node_id);
+    return it == links.end() ? SERVICE_NODE_LIST_SENTINEL : it->second.next;
+}
+
+uint64_t ServiceNodeList::prevServiceNodeID(uint64_t service_node_id) const {
+    auto it = links.find(service_node_id);
+    return it == links.end() ? SERVICE_NODE_LIST_SENTINEL : it->second.prev;
 }
 
 std::string ServiceNodeList::aggregatePubkeyHex() {
-    bls::PublicKey aggregate_pubkey; 
-    aggregate_pubkey.clear();
-    for(auto& node : nodes) {
-        aggregate_pubkey.add(node.getPublicKey());
+    return utils::BLSPublicKeyToHex(aggregatePubkey);
+}
+
+bls::Signature ServiceNodeList::aggregateSign(const PreparedMessage& message, std::span<const size_t> nodeIndices) {
+    switch (signingMode) {
+        case SigningMode::AggregateSecretKey: return aggregateSignSummedKey(message, nodeIndices);
+        case SigningMode::PerNode: return aggregateSignPerNode(message, nodeIndices);
+        case SigningMode::CrossCheck: {
+            bls::Signature result   = aggregateSignSummedKey(message, nodeIndices);
+            bls::Signature expected = aggregateSignPerNode(message, nodeIndices);
+            if (utils::SignatureToHex(result) != utils::SignatureToHex(expected))
+                throw std::runtime_error("Aggregate secret key signature does not match the per-node aggregate signature");
+            return result;
+        }
     }
-    return utils::BLSPublicKeyToHex(aggregate_pubkey);
+    throw std::runtime_error("Invalid signing mode");
+}
+
+std::shared_ptr<WorkerPool> ServiceNodeList::workerPool() {
+    std::lock_guard<std::mutex> lock{signingPoolMutex};
+    if (!signingPool && signingThreads != 1)
+        signingPool = std::make_shared<WorkerPool>(signingThreads);
+    return signingPool;
+}
+
+bls::Signature ServiceNodeList::aggregateSignPerNode(const PreparedMessage& message, std::span<const size_t> nodeIndices) {
+    // NOTE: Every signer multiplies the same `Hm`, past a handful of signers
+    // the table's build cost is repaid by the cheaper multiplications
+    if (!message.table && nodeIndices.size() >= precomputeMinSigners) {
+        PreparedMessage precomputed = message;
+        return aggregateSignPerNode(precomputed.precompute(nodeIndices.size()), nodeIndices);
+    }
+
+    auto signShard = [&](size_t begin, size_t end) {
+        bls::Signature partial;
+        partial.clear();
+        for (size_t index = begin; index < end; index++)
+            partial.add(nodes[nodeIndices[index]].signPrepared(message));
+        return partial;
+    };
+
+    std::shared_ptr<WorkerPool> pool = workerPool();
+    if (!pool)
+        return signShard(0, nodeIndices.size());
+
+    bls::Signature identity;
+    identity.clear();
+
+    // NOTE: The message was hashed to G2 once by the caller. Each shard signs
+    // and aggregates a contiguous run of the signers, the partial aggregates
+    // are then added together. G2 addition is associative so the result
+    // matches the serial aggregation exactly.
+    return pool->reduce(
+            nodeIndices.size(),
+            identity,
+            signShard,
+            [](bls::Signature lhs, const bls::Signature& rhs) {
+                lhs.add(rhs);
+                return lhs;
+            });
+}
+
+bls::Signature ServiceNodeList::aggregateSignSummedKey(const PreparedMessage& message, std::span<const size_t> nodeIndices) {
+    // NOTE: sum(Hm * sk_i) == Hm * sum(sk_i), we own every secret key so we
+    // can aggregate the keys in Fr and do a single G2 multiplication.
+    mcl::bn::Fr summedKey;
+    summedKey.clear();
+    for (size_t index : nodeIndices)
+        summedKey += nodes[index].getSecretScalar();
+    return mulHm(message, summedKey);
 }
 
 std::string ServiceNodeList::aggregateSignatures(const std::string& message, uint32_t chainID, std::string_view contractAddress) {
-    bls::Signature aggSig;
-    aggSig.clear();
+    return aggregateSignatures(message, domainTags(chainID, contractAddress));
+}
+
+std::string ServiceNodeList::aggregateSignatures(const std::string& message, const DomainTags& tags) {
     std::vector<uint8_t> messageBytes = ethyl::utils::fromHexString<uint8_t>(message);
-    for(auto& node : nodes) {
-        aggSig.add(node.blsSignHash(messageBytes, chainID, contractAddress));
-    }
+    std::vector<size_t>  nodeIndices(nodes.size());
+    for (size_t i = 0; i < nodeIndices.size(); i++)
+        nodeIndices[i] = i;
+    bls::Signature aggSig = aggregateSign(PreparedMessage::prepare(messageBytes, tags), nodeIndices);
     return utils::SignatureToHex(aggSig);
 }
 
 std::string ServiceNodeList::aggregateSignaturesFromIndices(const std::string& message, const std::vector<int64_t>& indices, uint32_t chainID, std::string_view contractAddress) {
-    bls::Signature aggSig;
-    aggSig.clear();
+    return aggregateSignaturesFromIndices(message, indices, domainTags(chainID, contractAddress));
+}
+
+std::string ServiceNodeList::aggregateSignaturesFromIndices(const std::string& message, const std::vector<int64_t>& indices, const DomainTags& tags) {
     std::vector<uint8_t> messageBytes = ethyl::utils::fromHexString<uint8_t>(message);
-    for(auto& index : indices) {
-        aggSig.add(nodes[static_cast<size_t>(index)].blsSignHash(messageBytes, chainID, contractAddress));
-    }
+    std::vector<size_t>  nodeIndices;
+    nodeIndices.reserve(indices.size());
+    for (auto& index : indices)
+        nodeIndices.push_back(static_cast<size_t>(index));
+    bls::Signature aggSig = aggregateSign(PreparedMessage::prepare(messageBytes, tags), nodeIndices);
     return utils::SignatureToHex(aggSig);
 }
 
 
-std::vector<uint64_t> ServiceNodeList::findNonSigners(const std::vector<uint64_t>& serviceNodeIDs) {
+std::vector<uint64_t> ServiceNodeList::findNonSigners(const SignerSet& signers) const {
+    // NOTE: IDs are allocated in ascending order and appended to the tail of
+    // the list so walking the list yields the non-signers sorted.
     std::vector<uint64_t> nonSignerIndices = {};
-    for (const auto& node: nodes) {
-        auto it = std::find(serviceNodeIDs.begin(), serviceNodeIDs.end(), node.service_node_id);
-        if (it == serviceNodeIDs.end()) {
-            nonSignerIndices.push_back(node.service_node_id);
-        }
+    nonSignerIndices.reserve(nodes.size());
+    for (uint64_t id = nextServiceNodeID(SERVICE_NODE_LIST_SENTINEL); id != SERVICE_NODE_LIST_SENTINEL; id = nextServiceNodeID(id)) {
+        if (!signers.contains(id))
+            nonSignerIndices.push_back(id);
     }
     return nonSignerIndices;
 }
 
+std::vector<uint64_t> ServiceNodeList::findNonSigners(const std::vector<uint64_t>& serviceNodeIDs) const {
+    return findNonSigners(SignerSet(serviceNodeIDs));
+}
+
 std::vector<uint64_t> ServiceNodeList::randomSigners(const size_t numOfRandomIndices) {
     if (numOfRandomIndices > nodes.size()) {
         throw std::invalid_argument("The number of random indices to choose is greater than the total number of indices available.");
@@ -295,45 +546,73 @@ std::tuple<std::string, uint64_t, std::string> ServiceNodeList::exitNodeFromIndi
         const std::vector<uint64_t>& service_node_ids,
         std::optional<std::chrono::system_clock::time_point> timestamp,
         bool liquidate) {
+    return exitNodeFromIndices(nodeID, domainTags(chainID, contractAddress), service_node_ids, timestamp, liquidate);
+}
+
+std::tuple<std::string, uint64_t, std::string> ServiceNodeList::exitNodeFromIndices(
+        uint64_t nodeID,
+        const DomainTags& tags,
+        const std::vector<uint64_t>& service_node_ids,
+        std::optional<std::chrono::system_clock::time_point> timestamp,
+        bool liquidate) {
     std::tuple<std::string, uint64_t, std::string> result;
     auto& [pubkey, ts, sig] = result;
 
-    pubkey = nodes[static_cast<size_t>(findNodeIndex(nodeID))].getPublicKeyHex();
-    std::string fullTag = buildTag(liquidate ? liquidateTag : exitTag, chainID, contractAddress);
-    ts = to_ts(timestamp.value_or(std::chrono::system_clock::now()));
-    std::string message = "0x" + fullTag + pubkey + ethyl::utils::padTo32Bytes(ethyl::utils::decimalToHex(ts), ethyl::utils::PaddingDirection::LEFT);
-    bls::Signature aggSig;
-    aggSig.clear();
-    std::vector<uint8_t> messageBytes = ethyl::utils::fromHexString<uint8_t>(message);
-    for(auto& service_node_id: service_node_ids) {
-        aggSig.add(nodes[static_cast<size_t>(findNodeIndex(service_node_id))].blsSignHash(messageBytes, chainID, contractAddress));
-    }
+    const std::array<uint8_t, 64> pubkeyBytes = utils::BLSPublicKeyToBytes(nodes[nodeIndex(nodeID)].getPublicKey());
+    pubkey = oxenc::to_hex(pubkeyBytes.begin(), pubkeyBytes.end());
+    ts     = to_ts(timestamp.value_or(std::chrono::system_clock::now()));
+
+    MessageBuilder message;
+    message.append(liquidate ? tags.liquidate : tags.exit).append(pubkeyBytes).appendU256(ts);
+    std::vector<size_t>  nodeIndices;
+    nodeIndices.reserve(service_node_ids.size());
+    for(auto& service_node_id: service_node_ids)
+        nodeIndices.push_back(nodeIndex(service_node_id));
+    bls::Signature aggSig = aggregateSign(PreparedMessage::prepare(message.bytes(), tags), nodeIndices);
     sig = utils::SignatureToHex(aggSig);
     return result;
 }
 
-std::string ServiceNodeList::updateRewardsBalance(const std::string& address, uint64_t amount, uint32_t chainID, const std::string& contractAddress, const std::vector<uint64_t>& service_node_ids) {
-    std::string rewardAddressOutput = address;
-    if (rewardAddressOutput.substr(0, 2) == "0x")
-        rewardAddressOutput = rewardAddressOutput.substr(2);  // remove "0x"
-    std::string fullTag = buildTag(rewardTag, chainID, contractAddress);
-    std::string message = "0x" + fullTag + ethyl::utils::padToNBytes(rewardAddressOutput, 20, ethyl::utils::PaddingDirection::LEFT) + ethyl::utils::padTo32Bytes(ethyl::utils::decimalToHex(amount), ethyl::utils::PaddingDirection::LEFT);
-    bls::Signature aggSig;
-    aggSig.clear();
-    std::vector<uint8_t> messageBytes = ethyl::utils::fromHexString<uint8_t>(message);
-    for(auto& service_node_id: service_node_ids) {
-        aggSig.add(nodes[static_cast<size_t>(findNodeIndex(service_node_id))].blsSignHash(messageBytes, chainID, contractAddress));
-    }
+std::string ServiceNodeList::updateRewardsBalance(const std::string& address, const Uint256& amount, uint32_t chainID, const std::string& contractAddress, const std::vector<uint64_t>& service_node_ids) {
+    return updateRewardsBalance(address, amount, domainTags(chainID, contractAddress), service_node_ids);
+}
+
+std::string ServiceNodeList::updateRewardsBalance(const std::string& address, const Uint256& amount, const DomainTags& tags, const std::vector<uint64_t>& service_node_ids) {
+    MessageBuilder message;
+    message.append(tags.reward).appendAddress(address).appendU256(amount);
+    std::vector<size_t>  nodeIndices;
+    nodeIndices.reserve(service_node_ids.size());
+    for(auto& service_node_id: service_node_ids)
+        nodeIndices.push_back(nodeIndex(service_node_id));
+    bls::Signature aggSig = aggregateSign(PreparedMessage::prepare(message.bytes(), tags), nodeIndices);
     return utils::SignatureToHex(aggSig);
 }
 
-int64_t ServiceNodeList::findNodeIndex(uint64_t service_node_id) {
-    for (size_t i = 0; i < nodes.size(); ++i) {
-        if (nodes[i].service_node_id == service_node_id) {
-            return static_cast<int64_t>(i); // Cast size_t to int
-        }
+int64_t ServiceNodeList::findNodeIndex(uint64_t service_node_id) const {
+    auto it = nodeIndices.find(service_node_id);
+    if (it == nodeIndices.end())
+        return -1; // Indicate that no node was found with the given id
+    return static_cast<int64_t>(it->second);
+}
+
+size_t ServiceNodeList::nodeIndex(uint64_t service_node_id) const {
+    auto it = nodeIndices.find(service_node_id);
+    if (it == nodeIndices.end()) {
+        std::stringstream stream;
+        stream << "Service node " << service_node_id << " is not in the service node list";
+        throw std::invalid_argument(stream.str());
     }
-    return -1; // Indicate that no node was found with the given id
+    return it->second;
 }
 
+const DomainTags& ServiceNodeList::domainTags(uint32_t chainID, std::string_view contractAddress) {
+    // NOTE: Normalise the address so that differently formatted addresses of
+    // the same contract share the cache entry
+    std::string key{ethyl::utils::trimPrefix(contractAddress, "0x")};
+    std::transform(key.begin(), key.end(), key.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
 
+    auto it = domainTagCache.find({chainID, key});
+    if (it == domainTagCache.end())
+        it = domainTagCache.emplace(std::make_pair(chainID, std::move(key)), DomainTags(chainID, contractAddress)).first;
+    return it->second;
+}
@@ -1,150 +1,248 @@
 #include "service_node_rewards/service_node_rewards_contract.hpp"
+#include "service_node_rewards/abi.hpp"
 #include "ethyl/utils.hpp"
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
+#include <cassert>
+#include <sstream>
+
 ethyl::Transaction ServiceNodeRewardsContract::addBLSPublicKey(const std::string& publicKey, const std::string& sig, const std::string& serviceNodePubkey, const std::string& serviceNodeSignature, const uint64_t fee) {
     ethyl::Transaction tx(contractAddress, 0, 3000000);
-    std::string functionSelector = ethyl::utils::toEthFunctionSignature("addBLSPublicKey((uint256,uint256),(uint256,uint256,uint256,uint256),(uint256,uint256,uint256,uint16),((address,address),uint256)[])");
-
-    const std::string serviceNodePubkeyPadded = ethyl::utils::padTo32Bytes(oxenc::to_hex(serviceNodePubkey), ethyl::utils::PaddingDirection::LEFT);
-    const std::string serviceNodeSignaturePadded = ethyl::utils::padToNBytes(oxenc::to_hex(serviceNodeSignature), 64, ethyl::utils::PaddingDirection::LEFT);
-    const std::string fee_padded = ethyl::utils::padTo32Bytes(ethyl::utils::decimalToHex(fee), ethyl::utils::PaddingDirection::LEFT);
-
-    // 11 parameters before the contributors array
-    const std::string contributors_offset = ethyl::utils::padTo32Bytes(ethyl::utils::decimalToHex(11 * 32), ethyl::utils::PaddingDirection::LEFT);
-    // empty for now
-    const std::string contributors = ethyl::utils::padTo32Bytes(ethyl::utils::decimalToHex(0), ethyl::utils::PaddingDirection::LEFT);
-
-    tx.data = functionSelector + publicKey + sig + serviceNodePubkeyPadded + serviceNodeSignaturePadded + fee_padded + contributors_offset + contributors;
-
+    std::string_view functionSelector = ADD_BLS_PUBLIC_KEY;
+
+    // 11 words before the contributors array: 2x pubkey, 4x sig, ed25519
+    // pubkey, 2x ed25519 sig, fee and the pointer to the array
+    const size_t HEAD_WORDS = 11;
+    AbiEncoder   abi{functionSelector, HEAD_WORDS + AbiEncoder::uintArrayWords(0)};
+    abi.words(publicKey)
+       .words(sig)
+       .leftPadded(std::span(reinterpret_cast<const uint8_t*>(serviceNodePubkey.data()), serviceNodePubkey.size()), 1)
+       .leftPadded(std::span(reinterpret_cast<const uint8_t*>(serviceNodeSignature.data()), serviceNodeSignature.size()), 2)
+       .uint(fee)
+       .offset(HEAD_WORDS)
+       .uint(0); // NOTE: Contributors, empty for now
+
+    tx.data = std::move(abi).str();
     return tx;
 }
 
 ContractServiceNode ServiceNodeRewardsContract::serviceNodes(uint64_t index)
 {
-    nlohmann::json callResult;
+    std::string callResultHex;
     try {
-        std::string  indexABI            = ethyl::utils::padTo32Bytes(ethyl::utils::decimalToHex(index), ethyl::utils::PaddingDirection::LEFT);
-        auto data                        = ethyl::utils::toEthFunctionSignature("serviceNodes(uint64)") + indexABI;
-        callResult                       = provider.callReadFunctionJSON(contractAddress, data);
-        const std::string& callResultHex = callResult.get_ref<nlohmann::json::string_t&>();
-        std::string_view   callResultIt  = ethyl::utils::trimPrefix(callResultHex, "0x");
-
-        const size_t        U256_HEX_SIZE                  = (256 / 8) * 2;
-        const size_t        BLS_PKEY_XY_COMPONENT_HEX_SIZE = 32 * 2;
-        const size_t        BLS_PKEY_HEX_SIZE              = BLS_PKEY_XY_COMPONENT_HEX_SIZE + BLS_PKEY_XY_COMPONENT_HEX_SIZE;
-        const size_t        ADDRESS_HEX_SIZE               = 32 * 2;
-        const size_t        ETH_ADDRESS_HEX_SIZE           = 20 * 2;
-
-        ContractServiceNode result                         = {};
-        size_t              walkIt                         = 0;
-        std::string_view    initialElementOffset           = callResultIt.substr(walkIt, U256_HEX_SIZE);     walkIt += initialElementOffset.size();
-        std::string_view    nextHex                        = callResultIt.substr(walkIt, U256_HEX_SIZE);     walkIt += nextHex.size();
-        std::string_view    prevHex                        = callResultIt.substr(walkIt, U256_HEX_SIZE);     walkIt += prevHex.size();
-        std::string_view    operatorAddressHex             = callResultIt.substr(walkIt, ADDRESS_HEX_SIZE);  walkIt += operatorAddressHex.size();
-        std::string_view    pubkeyHex                      = callResultIt.substr(walkIt, BLS_PKEY_HEX_SIZE); walkIt += pubkeyHex.size();
-        std::string_view    addedTimestampHex              = callResultIt.substr(walkIt, U256_HEX_SIZE);     walkIt += addedTimestampHex.size();
-        std::string_view    leaveRequestTimestampHex       = callResultIt.substr(walkIt, U256_HEX_SIZE);     walkIt += leaveRequestTimestampHex.size();
-        std::string_view    latestLeaveRequestTimestampHex = callResultIt.substr(walkIt, U256_HEX_SIZE);     walkIt += leaveRequestTimestampHex.size();
-        std::string_view    depositHex                     = callResultIt.substr(walkIt, U256_HEX_SIZE);     walkIt += depositHex.size();
-        std::string_view    contributorOffsetHex           = callResultIt.substr(walkIt, U256_HEX_SIZE);     walkIt += contributorOffsetHex.size();
-        std::string_view    ed25519PubkeyHex               = callResultIt.substr(walkIt, U256_HEX_SIZE);     walkIt += ed25519PubkeyHex.size();
-        std::string_view    contributorCountHex            = callResultIt.substr(walkIt, U256_HEX_SIZE);     walkIt += contributorCountHex.size();
-
-        // NOTE: Deserialize linked list
-        result.next                = ethyl::utils::hexStringToU64(nextHex);
-        result.prev                = ethyl::utils::hexStringToU64(prevHex);
-
-        // only need to fill in next and prev for sentinel, and probably not even those
-        if (index == 0) return result;
-
-        size_t contributor_count = ethyl::utils::hexStringToU64(contributorCountHex);
-        for (size_t i=0; i < contributor_count; i++) {
-            Contributor c;
-            std::string_view contributorAddressHex = callResultIt.substr(walkIt, ADDRESS_HEX_SIZE);    walkIt += contributorAddressHex.size();
-            std::string_view beneficiaryAddressHex = callResultIt.substr(walkIt, ADDRESS_HEX_SIZE);    walkIt += beneficiaryAddressHex.size();
-            std::string_view contributorAmountHex  = callResultIt.substr(walkIt, U256_HEX_SIZE);       walkIt += contributorAmountHex.size();
-
-            std::vector<unsigned char> addressBytes = ethyl::utils::fromHexString(contributorAddressHex.substr(contributorAddressHex.size() - ETH_ADDRESS_HEX_SIZE, ETH_ADDRESS_HEX_SIZE));
-            assert(addressBytes.size() == sizeof(Contributor::address));
-            std::memcpy(c.address.data(), addressBytes.data(), addressBytes.size());
-
-            std::vector<unsigned char> beneficiaryAddressBytes = ethyl::utils::fromHexString(beneficiaryAddressHex.substr(beneficiaryAddressHex.size() - ETH_ADDRESS_HEX_SIZE, ETH_ADDRESS_HEX_SIZE));
-            assert(beneficiaryAddressBytes.size() == sizeof(Contributor::beneficiaryAddress));
-            std::memcpy(c.beneficiaryAddress.data(), beneficiaryAddressBytes.data(), beneficiaryAddressBytes.size());
-
-            c.amount = ethyl::utils::hexStringToU64(contributorAmountHex);
-            result.contributors.push_back(std::move(c));
-        }
-        assert(walkIt == callResultIt.size());
-
-        // NOTE: Deserialise recipient
-        std::vector<unsigned char> recipientBytes = ethyl::utils::fromHexString(operatorAddressHex.substr(operatorAddressHex.size() - ETH_ADDRESS_HEX_SIZE, ETH_ADDRESS_HEX_SIZE));
-        assert(recipientBytes.size() == result.recipient.max_size());
-        std::memcpy(result.recipient.data(), recipientBytes.data(), recipientBytes.size());
-
-        // NOTE: Deserialise key hex into BLS key
-        result.pubkey = utils::HexToBLSPublicKey(pubkeyHex);
-
-        // NOTE: Deserialise metadata
-        result.addedTimestamp = ethyl::utils::hexStringToU64(addedTimestampHex);
-        result.leaveRequestTimestamp =
-            ethyl::utils::hexStringToU64(leaveRequestTimestampHex);
-        result.latestLeaveRequestTimestamp =
-            ethyl::utils::hexStringToU64(latestLeaveRequestTimestampHex);
-        result.deposit = depositHex;
-        result.ed25519Pubkey = ed25519PubkeyHex;
-        return result;
+        callResultHex = rpc->ethCall(contractAddress, serviceNodesCallData(index));
+        return decodeServiceNode(callResultHex, /*linksOnly*/ index == 0);
     } catch (const std::exception& e) {
-        throw std::runtime_error{std::string("response: ") + callResult.dump()};
+        throw std::runtime_error{std::string(e.what()) + ", response: " + callResultHex};
+    }
+}
+
+std::vector<ContractServiceNode> ServiceNodeRewardsContract::serviceNodes(JsonRpcBatch& batch, std::span<const uint64_t> ids)
+{
+    assert(batch.size() == 0);
+    for (uint64_t id : ids)
+        batch.ethCall(contractAddress, serviceNodesCallData(id));
+
+    std::vector<nlohmann::json>      callResults = batch.execute();
+    std::vector<ContractServiceNode> result;
+    result.reserve(callResults.size());
+    for (size_t index = 0; index < callResults.size(); index++) {
+        const std::string& callResultHex = callResults[index].get_ref<const nlohmann::json::string_t&>();
+        result.push_back(decodeServiceNode(callResultHex, /*linksOnly*/ ids[index] == 0));
+    }
+    return result;
+}
+
+std::vector<ContractServiceNode> ServiceNodeRewardsContract::serviceNodes(Multicall3& multicall, std::span<const uint64_t> ids)
+{
+    assert(multicall.size() == 0);
+    for (uint64_t id : ids)
+        multicall.add(contractAddress, serviceNodesCallData(id));
+
+    std::vector<Multicall3::Result>  callResults = multicall.execute(*rpc);
+    std::vector<ContractServiceNode> result;
+    result.reserve(callResults.size());
+    for (size_t index = 0; index < callResults.size(); index++)
+        result.push_back(decodeServiceNode(callResults[index].returnData, /*linksOnly*/ ids[index] == 0));
+    return result;
+}
+
+ContractServiceNode ServiceNodeRewardsContract::decodeServiceNode(std::string_view callResultHex, bool linksOnly)
+{
+    // NOTE: The struct has a dynamic member (contributors) so the return value
+    // is the offset to the tuple followed by the tuple itself
+    enum ServiceNodeWord : size_t {
+        Next,
+        Prev,
+        Operator,
+        PubkeyX,
+        PubkeyY,
+        AddedTimestamp,
+        LeaveRequestTimestamp,
+        LatestLeaveRequestTimestamp,
+        Deposit,
+        ContributorsOffset,
+        Ed25519Pubkey,
+    };
+
+    enum ContributorWord : size_t {
+        Address,
+        BeneficiaryAddress,
+        Amount,
+        ContributorWordCount,
+    };
+
+    AbiDecoder          tuple  = AbiDecoder{callResultHex}.tail(0);
+    ContractServiceNode result = {};
+
+    // NOTE: Deserialize linked list
+    result.next = tuple.uint64(Next);
+    result.prev = tuple.uint64(Prev);
+
+    // only need to fill in next and prev for sentinel, and probably not even those
+    if (linksOnly)
+        return result;
+
+    AbiDecoder contributors      = tuple.tail(ContributorsOffset);
+    uint64_t   contributor_count = contributors.uint64(0);
+    result.contributors.resize(contributor_count);
+    for (size_t i = 0; i < contributor_count; i++) {
+        Contributor& c      = result.contributors[i];
+        size_t       base   = 1 + i * ContributorWordCount;
+        c.address            = contributors.address(base + Address);
+        c.beneficiaryAddress = contributors.address(base + BeneficiaryAddress);
+        c.amount             = contributors.uint256(base + Amount);
     }
+
+    // NOTE: Deserialise recipient and the key hex into BLS key
+    result.recipient = tuple.address(Operator);
+    result.pubkey    = utils::HexToBLSPublicKey(tuple.wordsHex(PubkeyX, 2));
+
+    // NOTE: Deserialise metadata
+    result.addedTimestamp              = tuple.uint64(AddedTimestamp);
+    result.leaveRequestTimestamp       = tuple.uint64(LeaveRequestTimestamp);
+    result.latestLeaveRequestTimestamp = tuple.uint64(LatestLeaveRequestTimestamp);
+    result.deposit                     = tuple.uint256(Deposit);
+    result.ed25519Pubkey               = tuple.bytes32(Ed25519Pubkey);
+    return result;
 }
 
 uint64_t ServiceNodeRewardsContract::serviceNodeIDs(const bls::PublicKey& pKey)
 {
-    // NOTE: Generate the ABI caller data
-    std::string pKeyABI             = utils::BLSPublicKeyToHex(pKey);
-    std::string methodABI           = ethyl::utils::toEthFunctionSignature("serviceNodeIDs(bytes)");
-    std::string offsetToPKeyDataABI = ethyl::utils::padTo32Bytes(ethyl::utils::decimalToHex(32) /*offset includes the 32 byte offset itself*/, ethyl::utils::PaddingDirection::LEFT);
-    std::string bytesSizeABI        = ethyl::utils::padTo32Bytes(ethyl::utils::decimalToHex(pKeyABI.size() / 2), ethyl::utils::PaddingDirection::LEFT);
-
-    // NOTE: Setup call data
-
-    // NOTE: Fill in ABI
-    std::string data{};
-    data.reserve(methodABI.size() + offsetToPKeyDataABI.size() + bytesSizeABI.size() + pKeyABI.size());
-    data += methodABI;
-    data += offsetToPKeyDataABI;
-    data += bytesSizeABI;
-    data += pKeyABI;
-
-    // NOTE: Call function
-    nlohmann::json     callResult = provider.callReadFunctionJSON(contractAddress, data);
-    const std::string& resultHex  = callResult.get_ref<nlohmann::json::string_t&>();
-    uint64_t           result     = ethyl::utils::hexStringToU64(resultHex);
+    std::string resultHex = rpc->ethCall(contractAddress, serviceNodeIDsCallData(pKey));
+    uint64_t    result    = ethyl::utils::hexStringToU64(resultHex);
+    return result;
+}
+
+uint64_t ServiceNodeRewardsContract::ed25519ToServiceNodeID(std::span<const uint8_t, 32> ed25519Pubkey)
+{
+    std::string resultHex = rpc->ethCall(contractAddress, ed25519ToServiceNodeIDCallData(ed25519Pubkey));
+    return AbiDecoder{resultHex}.uint64(0);
+}
+
+std::string ServiceNodeRewardsContract::serviceNodesCallData(uint64_t index)
+{
+    AbiEncoder abi{SERVICE_NODES, 1};
+    abi.uint(index);
+    return std::move(abi).str();
+}
+
+std::string ServiceNodeRewardsContract::serviceNodeIDsCallData(const bls::PublicKey& pKey)
+{
+    std::array<uint8_t, 64> pKeyBytes = utils::BLSPublicKeyToBytes(pKey);
+    AbiEncoder              abi{SERVICE_NODE_IDS, 1 + AbiEncoder::bytesWords(pKeyBytes.size())};
+    abi.offset(1).bytes(pKeyBytes);
+    return std::move(abi).str();
+}
+
+std::string ServiceNodeRewardsContract::recipientsCallData(std::string_view address)
+{
+    AbiEncoder abi{RECIPIENTS, 1};
+    abi.address(address);
+    return std::move(abi).str();
+}
+
+std::string ServiceNodeRewardsContract::ed25519ToServiceNodeIDCallData(std::span<const uint8_t, 32> ed25519Pubkey)
+{
+    AbiEncoder abi{ED25519_TO_SERVICE_NODE_ID, 1};
+    abi.leftPadded(ed25519Pubkey, 1);
+    return std::move(abi).str();
+}
+
+ContractServiceNodeIDs ServiceNodeRewardsContract::allServiceNodeIDs()
+{
+    std::string callResultHex = rpc->ethCall(contractAddress, ALL_SERVICE_NODE_IDS);
+    return decodeAllServiceNodeIDs(callResultHex);
+}
+
+ContractServiceNodeIDs ServiceNodeRewardsContract::decodeAllServiceNodeIDs(std::string_view callResultHex)
+{
+    // NOTE: Two dynamic arrays, (uint64[] ids, G1Point[] pubkeys). A G1 point
+    // is a static struct of 2 words so the keys are packed inline.
+    AbiDecoder result  = AbiDecoder{callResultHex};
+    AbiDecoder ids     = result.tail(0);
+    AbiDecoder pubkeys = result.tail(1);
+
+    const uint64_t count = ids.uint64(0);
+    if (pubkeys.uint64(0) != count) {
+        std::stringstream stream;
+        stream << "Failed to decode allServiceNodeIDs, returned " << count << " IDs but " << pubkeys.uint64(0) << " public keys";
+        throw std::runtime_error(stream.str());
+    }
+
+    ContractServiceNodeIDs nodes;
+    nodes.ids.resize(count);
+    nodes.pubkeys.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        nodes.ids[i]     = ids.uint64(1 + i);
+        nodes.pubkeys[i] = utils::HexToBLSPublicKey(pubkeys.wordsHex(1 + i * 2, 2));
+    }
+    return nodes;
+}
+
+ServiceNodeListSnapshot ServiceNodeRewardsContract::snapshot()
+{
+    ServiceNodeListSnapshot result;
+    result.nodes           = allServiceNodeIDs();
+    result.aggregatePubkey = aggregatePubkey();
+
+    result.idsByPubkey.reserve(result.nodes.ids.size());
+    for (size_t i = 0; i < result.nodes.ids.size(); i++)
+        result.idsByPubkey.emplace_back(utils::BLSPublicKeyToBytes(result.nodes.pubkeys[i]), result.nodes.ids[i]);
+    std::sort(result.idsByPubkey.begin(), result.idsByPubkey.end());
     return result;
 }
 
+uint64_t ServiceNodeListSnapshot::findID(const bls::PublicKey& pubkey) const
+{
+    std::array<uint8_t, 64> key = utils::BLSPublicKeyToBytes(pubkey);
+    auto it = std::lower_bound(idsByPubkey.begin(), idsByPubkey.end(), key, [](const auto& entry, const auto& target) {
+        return entry.first < target;
+    });
+    return (it != idsByPubkey.end() && it->first == key) ? it->second : 0;
+}
+
 uint64_t ServiceNodeRewardsContract::totalNodes() {
-    auto data = ethyl::utils::toEthFunctionSignature("totalNodes()");
-    std::string result = provider.callReadFunction(contractAddress, data);
+    auto data = std::string(TOTAL_NODES.view());
+    std::string result = rpc->ethCall(contractAddress, data);
     return ethyl::utils::hexStringToU64(result);
 }
 
 uint64_t ServiceNodeRewardsContract::maxPermittedPubkeyAggregations() {
-    auto data = ethyl::utils::toEthFunctionSignature("maxPermittedPubkeyAggregations()");
-    std::string result = provider.callReadFunction(contractAddress, data);
+    auto data = std::string(MAX_PERMITTED_PUBKEY_AGGREGATIONS.view());
+    std::string result = rpc->ethCall(contractAddress, data);
     return ethyl::utils::hexStringToU64(result);
 }
 
 std::string ServiceNodeRewardsContract::designatedToken() {
-    auto data = ethyl::utils::toEthFunctionSignature("designatedToken()");
-    return provider.callReadFunction(contractAddress, data);
+    auto data = std::string(DESIGNATED_TOKEN.view());
+    return rpc->ethCall(contractAddress, data);
 }
 
 std::string ServiceNodeRewardsContract::aggregatePubkeyString() {
-    auto data            = ethyl::utils::toEthFunctionSignature("aggregatePubkey()");
-    return provider.callReadFunction(contractAddress, data);
+    auto data            = std::string(AGGREGATE_PUBKEY.view());
+    return rpc->ethCall(contractAddress, data);
 }
 
 bls::PublicKey ServiceNodeRewardsContract::aggregatePubkey() {
@@ -154,108 +252,114 @@ bls::PublicKey ServiceNodeRewardsContract::aggregatePubkey() {
 }
 
 Recipient ServiceNodeRewardsContract::viewRecipientData(const std::string& address) {
-    std::string rewardAddressOutput = address;
-    if (rewardAddressOutput.substr(0, 2) == "0x")
-        rewardAddressOutput = rewardAddressOutput.substr(2);  // remove "0x"
-    rewardAddressOutput = ethyl::utils::padTo32Bytes(rewardAddressOutput, ethyl::utils::PaddingDirection::LEFT);
-    auto data = ethyl::utils::toEthFunctionSignature("recipients(address)") + rewardAddressOutput;
+    std::string result = rpc->ethCall(contractAddress, recipientsCallData(address));
+    return decodeRecipient(result);
+}
 
-    std::string result = provider.callReadFunction(contractAddress, data);
+std::vector<Recipient> ServiceNodeRewardsContract::viewRecipientData(JsonRpcBatch& batch, std::span<const std::string> addresses) {
+    assert(batch.size() == 0);
+    for (const std::string& address : addresses)
+        batch.ethCall(contractAddress, recipientsCallData(address));
 
-    // This assumes both the returned integers fit into a uint64_t but they are actually uint256 and dont have a good way of storing the 
-    // full amount. In tests this will just mean that we need to keep our numbers below the 64bit max.
-    std::string rewardsHex = result.substr(2 + 64-8, 8);
-    std::string claimedHex = result.substr(2 + 64 + 64-8, 8);
+    std::vector<nlohmann::json> callResults = batch.execute();
+    std::vector<Recipient>      result;
+    result.reserve(callResults.size());
+    for (const nlohmann::json& callResult : callResults)
+        result.push_back(decodeRecipient(callResult.get_ref<const nlohmann::json::string_t&>()));
+    return result;
+}
 
-    uint64_t rewards = std::stoull(rewardsHex, nullptr, 16);
-    uint64_t claimed = std::stoull(claimedHex, nullptr, 16);
+std::vector<Recipient> ServiceNodeRewardsContract::viewRecipientData(Multicall3& multicall, std::span<const std::string> addresses) {
+    assert(multicall.size() == 0);
+    for (const std::string& address : addresses)
+        multicall.add(contractAddress, recipientsCallData(address));
+
+    std::vector<Multicall3::Result> callResults = multicall.execute(*rpc);
+    std::vector<Recipient>          result;
+    result.reserve(callResults.size());
+    for (const Multicall3::Result& callResult : callResults)
+        result.push_back(decodeRecipient(callResult.returnData));
+    return result;
+}
 
-    return Recipient(rewards, claimed);
+Recipient ServiceNodeRewardsContract::decodeRecipient(std::string_view callResultHex) {
+    AbiDecoder abi{callResultHex};
+    return Recipient(abi.uint256(0), abi.uint256(1));
 }
 
 ethyl::Transaction ServiceNodeRewardsContract::liquidateBLSPublicKeyWithSignature(const std::string& pubkey, const uint64_t timestamp, const std::string& sig, const std::vector<uint64_t>& non_signer_indices) {
     ethyl::Transaction tx(contractAddress, 0, 30000000);
-    std::string functionSelector = ethyl::utils::toEthFunctionSignature("liquidateBLSPublicKeyWithSignature((uint256,uint256),uint256,(uint256,uint256,uint256,uint256),uint64[])");
-    std::string timestamp_padded = ethyl::utils::padTo32Bytes(ethyl::utils::decimalToHex(timestamp), ethyl::utils::PaddingDirection::LEFT);
+    std::string_view functionSelector = LIQUIDATE_BLS_PUBLIC_KEY_WITH_SIGNATURE;
     // 8 Params: timestamp, 2x pubkey, 4x sig, pointer to array
-    std::string indices_padded = ethyl::utils::padTo32Bytes(ethyl::utils::decimalToHex(8*32), ethyl::utils::PaddingDirection::LEFT);
-    indices_padded += ethyl::utils::padTo32Bytes(ethyl::utils::decimalToHex(non_signer_indices.size()), ethyl::utils::PaddingDirection::LEFT);
-    for (const auto index: non_signer_indices) {
-        indices_padded += ethyl::utils::padTo32Bytes(ethyl::utils::decimalToHex(index), ethyl::utils::PaddingDirection::LEFT);
-    }
-    tx.data = functionSelector + pubkey + timestamp_padded + sig + indices_padded;
+    const size_t HEAD_WORDS = 8;
+    AbiEncoder   abi{functionSelector, HEAD_WORDS + AbiEncoder::uintArrayWords(non_signer_indices.size())};
+    abi.words(pubkey).uint(timestamp).words(sig).offset(HEAD_WORDS).uintArray(non_signer_indices);
+    tx.data = std::move(abi).str();
 
     return tx;
 }
 
 ethyl::Transaction ServiceNodeRewardsContract::exitBLSPublicKeyWithSignature(const std::string& pubkey, const uint64_t timestamp, const std::string& sig, const std::vector<uint64_t>& non_signer_indices) {
     ethyl::Transaction tx(contractAddress, 0, 30000000);
-    std::string functionSelector = ethyl::utils::toEthFunctionSignature("exitBLSPublicKeyWithSignature((uint256,uint256),uint256,(uint256,uint256,uint256,uint256),uint64[])");
-    std::string timestamp_padded = ethyl::utils::padTo32Bytes(ethyl::utils::decimalToHex(timestamp), ethyl::utils::PaddingDirection::LEFT);
+    std::string_view functionSelector = EXIT_BLS_PUBLIC_KEY_WITH_SIGNATURE;
     // 8 Params: timestamp, 2x pubkey, 4x sig, pointer to array
-    std::string indices_padded = ethyl::utils::padTo32Bytes(ethyl::utils::decimalToHex(8*32), ethyl::utils::PaddingDirection::LEFT);
-    indices_padded += ethyl::utils::padTo32Bytes(ethyl::utils::decimalToHex(non_signer_indices.size()), ethyl::utils::PaddingDirection::LEFT);
-    for (const auto index: non_signer_indices) {
-        indices_padded += ethyl::utils::padTo32Bytes(ethyl::utils::decimalToHex(index), ethyl::utils::PaddingDirection::LEFT);
-    }
-    tx.data = functionSelector + pubkey + timestamp_padded + sig + indices_padded;
+    const size_t HEAD_WORDS = 8;
+    AbiEncoder   abi{functionSelector, HEAD_WORDS + AbiEncoder::uintArrayWords(non_signer_indices.size())};
+    abi.words(pubkey).uint(timestamp).words(sig).offset(HEAD_WORDS).uintArray(non_signer_indices);
+    tx.data = std::move(abi).str();
 
     return tx;
 }
 
 ethyl::Transaction ServiceNodeRewardsContract::initiateExitBLSPublicKey(const uint64_t service_node_id) {
     ethyl::Transaction tx(contractAddress, 0, 3000000);
-    std::string functionSelector = ethyl::utils::toEthFunctionSignature("initiateExitBLSPublicKey(uint64)");
-    std::string node_id_padded = ethyl::utils::padTo32Bytes(ethyl::utils::decimalToHex(service_node_id), ethyl::utils::PaddingDirection::LEFT);
-    tx.data = functionSelector + node_id_padded;
+    std::string_view functionSelector = INITIATE_EXIT_BLS_PUBLIC_KEY;
+    AbiEncoder  abi{functionSelector, 1};
+    abi.uint(service_node_id);
+    tx.data = std::move(abi).str();
     return tx;
 }
 
 ethyl::Transaction ServiceNodeRewardsContract::exitBLSPublicKeyAfterWaitTime(const uint64_t service_node_id) {
     ethyl::Transaction tx(contractAddress, 0, 3000000);
-    std::string functionSelector = ethyl::utils::toEthFunctionSignature("exitBLSPublicKeyAfterWaitTime(uint64)");
-    std::string node_id_padded = ethyl::utils::padTo32Bytes(ethyl::utils::decimalToHex(service_node_id), ethyl::utils::PaddingDirection::LEFT);
-    tx.data = functionSelector + node_id_padded;
+    std::string_view functionSelector = EXIT_BLS_PUBLIC_KEY_AFTER_WAIT_TIME;
+    AbiEncoder  abi{functionSelector, 1};
+    abi.uint(service_node_id);
+    tx.data = std::move(abi).str();
     return tx;
 }
 
-ethyl::Transaction ServiceNodeRewardsContract::updateRewardsBalance(const std::string& address, const uint64_t amount, const std::string& sig, const std::vector<uint64_t>& non_signer_indices) {
+ethyl::Transaction ServiceNodeRewardsContract::updateRewardsBalance(const std::string& address, const Uint256& amount, const std::string& sig, const std::vector<uint64_t>& non_signer_indices) {
     ethyl::Transaction tx(contractAddress, 0, 30000000);
-    std::string functionSelector = ethyl::utils::toEthFunctionSignature("updateRewardsBalance(address,uint256,(uint256,uint256,uint256,uint256),uint64[])");
-    std::string rewardAddressOutput = address;
-    if (rewardAddressOutput.substr(0, 2) == "0x")
-        rewardAddressOutput = rewardAddressOutput.substr(2);  // remove "0x"
-    rewardAddressOutput = ethyl::utils::padTo32Bytes(rewardAddressOutput, ethyl::utils::PaddingDirection::LEFT);
-    std::string amount_padded = ethyl::utils::padTo32Bytes(ethyl::utils::decimalToHex(amount), ethyl::utils::PaddingDirection::LEFT);
+    std::string_view functionSelector = UPDATE_REWARDS_BALANCE;
     // 7 Params: addr, amount, 4x sig, pointer to array
-    std::string indices_padded = ethyl::utils::padTo32Bytes(ethyl::utils::decimalToHex(7*32), ethyl::utils::PaddingDirection::LEFT);
-    indices_padded += ethyl::utils::padTo32Bytes(ethyl::utils::decimalToHex(non_signer_indices.size()), ethyl::utils::PaddingDirection::LEFT);
-    for (const auto index: non_signer_indices) {
-        indices_padded += ethyl::utils::padTo32Bytes(ethyl::utils::decimalToHex(index), ethyl::utils::PaddingDirection::LEFT);
-    }
-    tx.data = functionSelector + rewardAddressOutput + amount_padded + sig + indices_padded;
+    const size_t HEAD_WORDS = 7;
+    AbiEncoder   abi{functionSelector, HEAD_WORDS + AbiEncoder::uintArrayWords(non_signer_indices.size())};
+    abi.address(address).uint(amount).words(sig).offset(HEAD_WORDS).uintArray(non_signer_indices);
+    tx.data = std::move(abi).str();
 
     return tx;
 }
 
 ethyl::Transaction ServiceNodeRewardsContract::claimRewards() {
     ethyl::Transaction tx(contractAddress, 0, 3000000);
-    std::string functionSelector = ethyl::utils::toEthFunctionSignature("claimRewards()");
+    std::string_view functionSelector = CLAIM_REWARDS;
     tx.data = functionSelector;
     return tx;
 }
 
-ethyl::Transaction ServiceNodeRewardsContract::claimRewards(uint64_t amount) {
+ethyl::Transaction ServiceNodeRewardsContract::claimRewards(const Uint256& amount) {
     ethyl::Transaction tx(contractAddress, 0, 3000000);
-    std::string functionSelector = ethyl::utils::toEthFunctionSignature("claimRewards(uint256)");
-    std::string amount_padded = ethyl::utils::padTo32Bytes(ethyl::utils::decimalToHex(amount), ethyl::utils::PaddingDirection::LEFT);
-    tx.data = functionSelector + amount_padded;
+    std::string_view functionSelector = CLAIM_REWARDS_AMOUNT;
+    AbiEncoder  abi{functionSelector, 1};
+    abi.uint(amount);
+    tx.data = std::move(abi).str();
     return tx;
 }
 
 ethyl::Transaction ServiceNodeRewardsContract::start() {
     ethyl::Transaction tx(contractAddress, 0, 3000000);
-    std::string functionSelector = ethyl::utils::toEthFunctionSignature("start()");
+    std::string_view functionSelector = START;
     tx.data = functionSelector;
     return tx;
 }
@@ -0,0 +1,165 @@
+#include "service_node_rewards/transaction_pipeline.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include "ethyl/utils.hpp"
+
+TransactionPipeline::TransactionPipeline(ethyl::Signer& _signer, std::vector<unsigned char> _seckey, std::string _url, size_t _maxInFlight)
+    : senderAddress(_signer.secretKeyToAddressString(_seckey))
+    , maxInFlight(std::max<size_t>(_maxInFlight, 1))
+    , signer(_signer)
+    , seckey(std::move(_seckey))
+    , url(std::move(_url)) {
+}
+
+size_t TransactionPipeline::submit(ethyl::Transaction tx) {
+    size_t result = entries.size();
+    entries.push_back(Entry{std::move(tx), {}, {}});
+    return result;
+}
+
+void TransactionPipeline::send(std::vector<size_t>& inFlight) {
+    if (sendCursor >= entries.size() || inFlight.size() >= maxInFlight)
+        return;
+
+    const size_t count = std::min(entries.size() - sendCursor, maxInFlight - inFlight.size());
+    if (!fees || !nextNonce)
+        sync();
+
+    JsonRpcBatch batch{url};
+    batch.transport = transport;
+    for (size_t index = sendCursor; index < sendCursor + count; index++) {
+        Entry& entry                  = entries[index];
+        entry.tx.chainId              = fees->chainId;
+        entry.tx.maxPriorityFeePerGas = fees->maxPriorityFeePerGas;
+        entry.tx.maxFeePerGas         = fees->maxFeePerGas;
+        entry.tx.nonce                = (*nextNonce)++;
+        entry.result.nonce            = entry.tx.nonce;
+
+        std::string raw = signer.signTransaction(entry.tx, seckey);
+        if (!raw.starts_with("0x"))
+            raw.insert(0, "0x");
+        batch.request("eth_sendRawTransaction", nlohmann::json::array({std::move(raw)}));
+    }
+
+    const auto                  sentAt = std::chrono::steady_clock::now();
+    std::vector<nlohmann::json> errors;
+    std::vector<nlohmann::json> hashes = batch.execute(errors);
+
+    bool rejected = false;
+    for (size_t offset = 0; offset < count; offset++) {
+        Entry& entry = entries[sendCursor + offset];
+        entry.sentAt = sentAt;
+        if (!errors[offset].is_null()) {
+            rejected           = true;
+            entry.result.error = errors[offset].dump();
+            continue;
+        }
+        entry.result.hash = hashes[offset].get<std::string>();
+        inFlight.push_back(sendCursor + offset);
+    }
+    sendCursor += count;
+
+    // NOTE: A rejected transaction may not have consumed its nonce, resync
+    // with the node before the next transactions are numbered
+    if (rejected)
+        nextNonce.reset();
+}
+
+void TransactionPipeline::sync() {
+    JsonRpcBatch batch{url};
+    batch.transport = transport;
+    batch.request("eth_chainId", nlohmann::json::array());
+    batch.request("eth_maxPriorityFeePerGas", nlohmann::json::array());
+    batch.request("eth_feeHistory", nlohmann::json::array({"0x1", "latest", nlohmann::json::array()}));
+    if (!nextNonce)
+        batch.request("eth_getTransactionCount", nlohmann::json::array({senderAddress, "pending"}));
+    std::vector<nlohmann::json> results = batch.execute();
+
+    // NOTE: The last base fee in the history is the next block's, allow it to
+    // double before the transactions are priced out of the following blocks
+    const nlohmann::json& baseFees = results[2].at("baseFeePerGas");
+    if (!baseFees.is_array() || baseFees.empty()) {
+        std::stringstream stream;
+        stream << "Node returned a fee history without base fees: " << results[2].dump();
+        throw std::runtime_error(stream.str());
+    }
+    const uint64_t baseFee = ethyl::utils::hexStringToU64(baseFees[baseFees.size() - 1].get<std::string>());
+
+    Fees& result                = fees.emplace();
+    result.chainId              = ethyl::utils::hexStringToU64(results[0].get<std::string>());
+    result.maxPriorityFeePerGas = ethyl::utils::hexStringToU64(results[1].get<std::string>());
+    result.maxFeePerGas         = 2 * baseFee + result.maxPriorityFeePerGas;
+    if (!nextNonce)
+        nextNonce = ethyl::utils::hexStringToU64(results[3].get<std::string>());
+}
+
+size_t TransactionPipeline::poll(std::vector<size_t>& inFlight) {
+    if (inFlight.empty())
+        return 0;
+
+    JsonRpcBatch batch{url};
+    batch.transport = transport;
+    for (size_t index : inFlight)
+        batch.request("eth_getTransactionReceipt", nlohmann::json::array({entries[index].result.hash}));
+    std::vector<nlohmann::json> receipts = batch.execute();
+
+    const auto now       = std::chrono::steady_clock::now();
+    size_t     remaining = 0;
+    for (size_t offset = 0; offset < inFlight.size(); offset++) {
+        size_t index = inFlight[offset];
+        if (receipts[offset].is_null()) {
+            inFlight[remaining++] = index; // NOTE: Still pending
+            continue;
+        }
+
+        Entry& entry         = entries[index];
+        entry.result.latency = now - entry.sentAt;
+        entry.result.success = receipts[offset].value("status", "") == "0x1";
+        entry.result.receipt = std::move(receipts[offset]);
+        if (!entry.result.success)
+            entry.result.error = "Transaction reverted";
+    }
+
+    size_t result = inFlight.size() - remaining;
+    inFlight.resize(remaining);
+    return result;
+}
+
+std::vector<TransactionPipeline::Result> TransactionPipeline::wait(std::chrono::milliseconds timeout, std::chrono::milliseconds pollInterval) {
+    const auto          deadline = std::chrono::steady_clock::now() + timeout;
+    std::vector<size_t> inFlight;
+    inFlight.reserve(maxInFlight);
+    fees.reset();
+
+    while (sendCursor < entries.size() || inFlight.size()) {
+        send(inFlight);
+        size_t mined = poll(inFlight);
+
+        if (std::chrono::steady_clock::now() >= deadline)
+            break;
+
+        // NOTE: Only back off when no slot was freed for the next transactions
+        if (mined == 0 && inFlight.size())
+            std::this_thread::sleep_for(pollInterval);
+    }
+
+    for (size_t index : inFlight) {
+        std::stringstream stream;
+        stream << "Transaction " << entries[index].result.hash << " was not mined within " << timeout.count() << "ms";
+        entries[index].result.error = stream.str();
+    }
+    for (size_t index = sendCursor; index < entries.size(); index++)
+        entries[index].result.error = "Transaction was not sent before the timeout";
+
+    std::vector<Result> result;
+    result.reserve(entries.size());
+    for (Entry& entry : entries)
+        result.push_back(std::move(entry.result));
+    entries.clear();
+    sendCursor = 0;
+    return result;
+}
@@ -0,0 +1,95 @@
+#include "service_node_rewards/uint256.hpp"
+
+#include "ethyl/utils.hpp"
+#include <oxenc/hex.h>
+
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+#include <stdexcept>
+
+Uint256 Uint256::fromHex(std::string_view hex) {
+    const size_t MAX_HEX_SIZE = 64;
+    hex                       = ethyl::utils::trimPrefix(hex, "0x");
+
+    // NOTE: Quantities are not padded to whole bytes, e.g. 0x1
+    if (!std::all_of(hex.begin(), hex.end(), [](unsigned char ch) { return std::isxdigit(ch); })) {
+        std::stringstream stream;
+        stream << "Failed to parse uint256, '" << hex << "' is not valid hex";
+        throw std::invalid_argument(stream.str());
+    }
+
+    std::string_view digits = hex.substr(std::min(hex.find_first_not_of('0'), hex.size()));
+    if (digits.size() > MAX_HEX_SIZE) {
+        std::stringstream stream;
+        stream << "Failed to parse uint256, '" << hex << "' has " << digits.size() << " significant hex digits, at most " << MAX_HEX_SIZE << " fit into 256 bits";
+        throw std::overflow_error(stream.str());
+    }
+
+    Uint256 result;
+    for (size_t i = 0; i < digits.size(); i++) {
+        char     ch    = digits[digits.size() - 1 - i];
+        uint64_t digit = static_cast<uint64_t>(oxenc::from_hex_digit(static_cast<unsigned char>(ch)));
+        result.limbs[i / 16] |= digit << ((i % 16) * 4);
+    }
+    return result;
+}
+
+void Uint256::toHex(std::span<char, 64> dst) const {
+    static constexpr char HEX_DIGITS[] = "0123456789abcdef";
+    for (size_t i = 0; i < dst.size(); i++)
+        dst[dst.size() - 1 - i] = HEX_DIGITS[(limbs[i / 16] >> ((i % 16) * 4)) & 0xf];
+}
+
+std::string Uint256::toHex() const {
+    std::string result(64, '0');
+    toHex(std::span<char, 64>(result.data(), result.size()));
+    return result;
+}
+
+std::string Uint256::toString() const {
+    // NOTE: Long division by 10^9 over 32 bit words, most significant first,
+    // each remainder is the next 9 decimal digits from the right. The partial
+    // dividend (remainder << 32 | word) stays below 10^9 * 2^32 < 2^64.
+    const uint32_t           CHUNK        = 1'000'000'000;
+    const size_t             CHUNK_DIGITS = 9;
+    std::array<uint32_t, 8>  words        = {};
+    for (size_t i = 0; i < words.size(); i++)
+        words[i] = static_cast<uint32_t>(limbs[3 - i / 2] >> (i % 2 ? 0 : 32));
+
+    // NOTE: 2^256 has 78 decimal digits
+    std::array<char, 81> buffer;
+    size_t               begin = buffer.size();
+    for (;;) {
+        uint64_t remainder = 0;
+        bool     zero      = true;
+        for (uint32_t& word : words) {
+            uint64_t dividend = (remainder << 32) | word;
+            word              = static_cast<uint32_t>(dividend / CHUNK);
+            remainder         = dividend % CHUNK;
+            zero              = zero && word == 0;
+        }
+
+        for (size_t i = 0; i < CHUNK_DIGITS && (!zero || remainder); i++, remainder /= 10)
+            buffer[--begin] = static_cast<char>('0' + remainder % 10);
+        if (zero)
+            break;
+    }
+
+    if (begin == buffer.size())
+        return "0";
+    return std::string(buffer.data() + begin, buffer.size() - begin);
+}
+
+uint64_t Uint256::toUint64() const {
+    if (!fitsUint64()) {
+        std::stringstream stream;
+        stream << "Failed to convert " << *this << " to a 64 bit integer, the value does not fit";
+        throw std::overflow_error(stream.str());
+    }
+    return limbs[0];
+}
+
+std::ostream& operator<<(std::ostream& stream, const Uint256& value) {
+    return stream << value.toString();
+}
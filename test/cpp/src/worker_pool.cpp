@@ -0,0 +1,36 @@
+#include "service_node_rewards/worker_pool.hpp"
+
+WorkerPool::WorkerPool(size_t threadCount) {
+    if (threadCount == 0)
+        threadCount = std::thread::hardware_concurrency();
+    threadCount = std::max<size_t>(threadCount, 1);
+
+    workers.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; i++)
+        workers.emplace_back([this]() { run(); });
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        stopping = true;
+    }
+    cv.notify_all();
+    for (auto& worker : workers)
+        worker.join();
+}
+
+void WorkerPool::run() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            cv.wait(lock, [this]() { return stopping || !tasks.empty(); });
+            if (tasks.empty())
+                return; // NOTE: Stopping and there's no more work to drain
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
@@ -0,0 +1,211 @@
+#include <array>
+#include <vector>
+
+#include "service_node_rewards/abi.hpp"
+#include "service_node_rewards/erc20_contract.hpp"
+#include "service_node_rewards/selector.hpp"
+#include "service_node_rewards/service_node_contribution_contract.hpp"
+#include "service_node_rewards/service_node_list.hpp"
+#include "service_node_rewards/service_node_rewards_contract.hpp"
+#include "service_node_rewards/uint256.hpp"
+#include "ethyl/utils.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_all.hpp>
+
+TEST_CASE("ABI encodes static arguments", "[abi]") {
+    // NOTE: transfer(address,uint256)
+    AbiEncoder abi{"0xa9059cbb", 2};
+    abi.address("0x70997970C51812dc3A010C7d01b50e0d17dc79C8").uint(1'000'000);
+    CHECK(abi.str() == "0xa9059cbb" + std::string(24, '0') + "70997970C51812dc3A010C7d01b50e0d17dc79C8" + Uint256(0xf4240).toHex());
+
+    // NOTE: Raw bytes are left padded, pre-encoded words are copied verbatim
+    const std::array<uint8_t, 2> payload = {0xab, 0xcd};
+    AbiEncoder padded{"12345678", 3};
+    padded.leftPadded(payload, 1).words(Uint256(1).toHex()).uint(0);
+    CHECK(padded.str() == "0x12345678" + Uint256(0xabcd).toHex() + Uint256(1).toHex() + Uint256(0).toHex());
+}
+
+TEST_CASE("ABI encodes dynamic arrays and bytes into a single allocation", "[abi]") {
+    std::vector<uint64_t> indices(1000);
+    for (size_t i = 0; i < indices.size(); i++)
+        indices[i] = i;
+
+    const size_t HEAD_WORDS = 2;
+    AbiEncoder   abi{"0x12345678", HEAD_WORDS + AbiEncoder::uintArrayWords(indices.size())};
+    const char*  buffer = abi.str().data();
+    abi.uint(7).offset(HEAD_WORDS).uintArray(indices);
+    CHECK(abi.str().data() == buffer);
+
+    std::string expected = "0x12345678" + Uint256(7).toHex() + Uint256(0x40).toHex() + Uint256(0x3e8).toHex();
+    for (uint64_t index : indices)
+        expected += Uint256(index).toHex();
+    CHECK(abi.str() == expected);
+
+    // NOTE: serviceNodeIDs(bytes) with a 3 byte payload, data is right padded
+    const std::array<uint8_t, 3> payload = {0x01, 0x02, 0xff};
+    AbiEncoder bytes{"0x12345678", 1 + AbiEncoder::bytesWords(payload.size())};
+    bytes.offset(1).bytes(payload);
+    CHECK(bytes.str() == "0x12345678" + Uint256(0x20).toHex() + Uint256(3).toHex() + "0102ff" + std::string(58, '0'));
+}
+
+TEST_CASE("ABI encoder rejects malformed input", "[abi]") {
+    CHECK_THROWS(AbiEncoder{"0x1234", 0});
+    CHECK_THROWS(AbiEncoder{"0x1234567z", 0});
+
+    AbiEncoder abi{"0x12345678", 0};
+    CHECK_THROWS(abi.address("0x" + std::string(42, 'a')));
+    CHECK_THROWS(abi.address("0xnothex"));
+    CHECK_THROWS(abi.words("abcd"));
+    const std::array<uint8_t, 33> tooLarge = {};
+    CHECK_THROWS(abi.leftPadded(tooLarge, 1));
+}
+
+// NOTE: Selectors from the Solidity ABI of OpenZeppelin's ERC20, e.g.
+// `IERC20.transfer.selector`
+static_assert(ERC20Contract::TRANSFER.view() == "0xa9059cbb");
+static_assert(ERC20Contract::BALANCE_OF.view() == "0x70a08231");
+static_assert(ERC20Contract::APPROVE.view() == "0x095ea7b3");
+static_assert(FunctionSelector{"transferFrom(address,address,uint256)"}.view() == "0x23b872dd");
+static_assert(constexpr_keccak::keccak256("")[0] == 0xc5 && constexpr_keccak::keccak256("")[31] == 0x70);
+
+TEST_CASE("Compile time selectors match the runtime selectors", "[abi]") {
+    const FunctionSelector selectors[] = {
+            ServiceNodeRewardsContract::ADD_BLS_PUBLIC_KEY,
+            ServiceNodeRewardsContract::SERVICE_NODES,
+            ServiceNodeRewardsContract::SERVICE_NODE_IDS,
+            ServiceNodeRewardsContract::TOTAL_NODES,
+            ServiceNodeRewardsContract::MAX_PERMITTED_PUBKEY_AGGREGATIONS,
+            ServiceNodeRewardsContract::DESIGNATED_TOKEN,
+            ServiceNodeRewardsContract::AGGREGATE_PUBKEY,
+            ServiceNodeRewardsContract::RECIPIENTS,
+            ServiceNodeRewardsContract::LIQUIDATE_BLS_PUBLIC_KEY_WITH_SIGNATURE,
+            ServiceNodeRewardsContract::EXIT_BLS_PUBLIC_KEY_WITH_SIGNATURE,
+            ServiceNodeRewardsContract::INITIATE_EXIT_BLS_PUBLIC_KEY,
+            ServiceNodeRewardsContract::EXIT_BLS_PUBLIC_KEY_AFTER_WAIT_TIME,
+            ServiceNodeRewardsContract::UPDATE_REWARDS_BALANCE,
+            ServiceNodeRewardsContract::CLAIM_REWARDS,
+            ServiceNodeRewardsContract::CLAIM_REWARDS_AMOUNT,
+            ServiceNodeRewardsContract::START,
+            ServiceNodeRewardsContract::ALL_SERVICE_NODE_IDS,
+            ServiceNodeRewardsContract::ED25519_TO_SERVICE_NODE_ID,
+            ServiceNodeContributionContract::CONTRIBUTE_FUNDS,
+            ServiceNodeContributionContract::FINALIZE,
+            ServiceNodeContributionContract::RESET,
+            ServiceNodeContributionContract::WITHDRAW_CONTRIBUTION,
+            ServiceNodeContributionContract::RESET_UPDATE_AND_CONTRIBUTE,
+            ServiceNodeContributionContract::GET_CONTRIBUTIONS,
+            ServiceNodeContributionContract::GET_RESERVED,
+            ServiceNodeContributionContract::BLS_SIGNATURE,
+            ServiceNodeContributionContract::SERVICE_NODE_PARAMS,
+            ServiceNodeContributionContract::STATUS,
+    };
+    const std::string_view signatures[] = {
+            "addBLSPublicKey((uint256,uint256),(uint256,uint256,uint256,uint256),(uint256,uint256,uint256,uint16),((address,address),uint256)[])",
+            "serviceNodes(uint64)",
+            "serviceNodeIDs(bytes)",
+            "totalNodes()",
+            "maxPermittedPubkeyAggregations()",
+            "designatedToken()",
+            "aggregatePubkey()",
+            "recipients(address)",
+            "liquidateBLSPublicKeyWithSignature((uint256,uint256),uint256,(uint256,uint256,uint256,uint256),uint64[])",
+            "exitBLSPublicKeyWithSignature((uint256,uint256),uint256,(uint256,uint256,uint256,uint256),uint64[])",
+            "initiateExitBLSPublicKey(uint64)",
+            "exitBLSPublicKeyAfterWaitTime(uint64)",
+            "updateRewardsBalance(address,uint256,(uint256,uint256,uint256,uint256),uint64[])",
+            "claimRewards()",
+            "claimRewards(uint256)",
+            "start()",
+            "allServiceNodeIDs()",
+            "ed25519ToServiceNodeID(uint256)",
+            "contributeFunds(uint256,address)",
+            "finalize()",
+            "reset()",
+            "withdrawContribution()",
+            "resetUpdateAndContribute((uint256,uint256),(uint256,uint256,uint256,uint256),(uint256,uint256,uint256,uint16),(address,uint256)[],bool,address,uint256)",
+            "getContributions()",
+            "getReserved()",
+            "blsSignature()",
+            "serviceNodeParams()",
+            "status()",
+    };
+    static_assert(std::size(selectors) == std::size(signatures));
+
+    for (size_t i = 0; i < std::size(selectors); i++) {
+        INFO(signatures[i]);
+        CHECK(selectors[i].view() == ethyl::utils::toEthFunctionSignature(std::string(signatures[i])));
+    }
+}
+
+TEST_CASE("ABI decodes words and resolves dynamic offsets", "[abi]") {
+    // NOTE: Returned (uint64, uint64[]) = (5, [1, 2])
+    const std::string result = "0x" + Uint256(5).toHex() + Uint256(0x40).toHex() + Uint256(2).toHex() + Uint256(1).toHex() + Uint256(2).toHex();
+    AbiDecoder        abi{result};
+    CHECK(abi.words() == 5);
+    CHECK(abi.uint64(0) == 5);
+
+    AbiDecoder array = abi.tail(1);
+    REQUIRE(array.uint64(0) == 2);
+    CHECK(array.uint64(1) == 1);
+    CHECK(array.uint64(2) == 2);
+
+    CHECK_THROWS(AbiDecoder{"0x1234"});
+    CHECK_THROWS(abi.uint64(5));
+    CHECK_THROWS(AbiDecoder{"0x" + Uint256::fromHex("10000000000000000").toHex()}.uint64(0));
+    CHECK_THROWS(AbiDecoder{"0x" + Uint256(0x21).toHex()}.tail(0));
+    CHECK_THROWS(AbiDecoder{"0x" + Uint256(0x40).toHex()}.tail(0));
+}
+
+TEST_CASE("ABI decodes the serviceNodes() return value", "[abi]") {
+    ServiceNodeList   snl(1, 1);
+    const std::string pubkeyHex    = snl.nodes[0].getPublicKeyHex();
+    const std::string operatorHex  = "70997970c51812dc3a010c7d01b50e0d17dc79c8";
+    const std::string stakerHex    = "3c44cdddb6a900fa2b585dd299e03d12fa4293bc";
+    const std::string ed25519Hex   = std::string(62, '0') + "ab";
+    const std::string operatorWord = std::string(24, '0') + operatorHex;
+    const std::string stakerWord   = std::string(24, '0') + stakerHex;
+
+    // NOTE: Offset to the tuple, the tuple's 11 head words then the
+    // contributors array of 1 element
+    std::string result = "0x" + Uint256(0x20).toHex();
+    result += Uint256(3).toHex() + Uint256(1).toHex() + operatorWord + pubkeyHex + Uint256(0x64).toHex() + Uint256(0).toHex() + Uint256(0).toHex() +
+              Uint256(0x1bf08eb000).toHex() + Uint256(0x160).toHex() + ed25519Hex;
+    result += Uint256(1).toHex() + stakerWord + operatorWord + Uint256(0x1bf08eb000).toHex();
+
+    ContractServiceNode node = ServiceNodeRewardsContract::decodeServiceNode(result);
+    CHECK(node.next == 3);
+    CHECK(node.prev == 1);
+    CHECK(oxenc::to_hex(node.recipient.begin(), node.recipient.end()) == operatorHex);
+    CHECK(node.pubkey == snl.nodes[0].getPublicKey());
+    CHECK(node.addedTimestamp == 100);
+    CHECK(node.deposit == 0x1bf08eb000);
+    CHECK(oxenc::to_hex(node.ed25519Pubkey.begin(), node.ed25519Pubkey.end()) == ed25519Hex);
+    REQUIRE(node.contributors.size() == 1);
+    CHECK(oxenc::to_hex(node.contributors[0].address.begin(), node.contributors[0].address.end()) == stakerHex);
+    CHECK(oxenc::to_hex(node.contributors[0].beneficiaryAddress.begin(), node.contributors[0].beneficiaryAddress.end()) == operatorHex);
+    CHECK(node.contributors[0].amount == ServiceNodeRewardsContract::STAKING_REQUIREMENT);
+
+    ContractServiceNode links = ServiceNodeRewardsContract::decodeServiceNode(result, /*linksOnly*/ true);
+    CHECK(links.next == 3);
+    CHECK(links.contributors.empty());
+}
+
+TEST_CASE("ABI decodes the allServiceNodeIDs() return value", "[abi]") {
+    ServiceNodeList snl(3, 1);
+
+    // NOTE: Offsets of both arrays, 3 IDs then 3 inline G1 points
+    std::string result = "0x" + Uint256(0x40).toHex() + Uint256(0xc0).toHex() + Uint256(3).toHex() + Uint256(2).toHex() + Uint256(3).toHex() + Uint256(1).toHex() + Uint256(3).toHex();
+    for (uint64_t id : std::initializer_list<uint64_t>{2, 3, 1})
+        result += snl.nodes[static_cast<size_t>(snl.findNodeIndex(id))].getPublicKeyHex();
+
+    ContractServiceNodeIDs nodes = ServiceNodeRewardsContract::decodeAllServiceNodeIDs(result);
+    CHECK(nodes.ids == std::vector<uint64_t>{2, 3, 1});
+    REQUIRE(nodes.pubkeys.size() == 3);
+    for (size_t i = 0; i < nodes.ids.size(); i++)
+        CHECK(nodes.pubkeys[i] == snl.nodes[static_cast<size_t>(snl.findNodeIndex(nodes.ids[i]))].getPublicKey());
+
+    // NOTE: Mismatched array lengths are rejected
+    std::string mismatched = "0x" + Uint256(0x40).toHex() + Uint256(0x80).toHex() + Uint256(1).toHex() + Uint256(2).toHex() + Uint256(0).toHex();
+    CHECK_THROWS(ServiceNodeRewardsContract::decodeAllServiceNodeIDs(mismatched));
+}
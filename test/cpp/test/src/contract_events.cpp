@@ -0,0 +1,100 @@
+#include <string>
+
+#include "service_node_rewards/contract_events.hpp"
+#include "service_node_rewards/contract_sync.hpp"
+#include "service_node_rewards/uint256.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_all.hpp>
+
+// NOTE: Topic of ERC20's `Transfer` event, e.g. `IERC20.Transfer.selector`
+static_assert(EventTopic{"Transfer(address,address,uint256)"}.view() == "0xddf252ad1be2c89b69c2b068fc378daa952ba7f163c4a11628f55a4df523b3ef");
+
+static std::string addressWord(std::string_view address) {
+    return std::string(24, '0') + std::string(address);
+}
+
+// NOTE: The generator of G1, (1, 2), is a valid BLS public key
+static const std::string PUBKEY_HEX  = Uint256(1).toHex() + Uint256(2).toHex();
+static const std::string OPERATOR    = "70997970c51812dc3a010c7d01b50e0d17dc79c8";
+static const std::string BENEFICIARY = "3c44cdddb6a900fa2b585dd299e03d12fa4293bc";
+static const std::string ED25519     = "d3c208c16d87cfd3d3c208c16d87cfd3d3c208c16d87cfd3d3c208c16d87cfd3";
+
+static nlohmann::json makeLog(std::string_view topic0, std::string topic1, std::string data, uint64_t block, uint64_t logIndex) {
+    return nlohmann::json{
+            {"address", "0x5fc8d32690cc91d4c39d9d3abcbd16989f875707"},
+            {"topics", nlohmann::json::array({topic0, "0x" + topic1})},
+            {"data", "0x" + data},
+            {"blockNumber", "0x" + Uint256(block).toHex().substr(48)},
+            {"transactionHash", "0x" + Uint256(block).toHex()},
+            {"logIndex", "0x" + Uint256(logIndex).toHex().substr(48)},
+            {"removed", false},
+    };
+}
+
+TEST_CASE("Contract events are decoded from logs", "[events]") {
+    // NOTE: NewServiceNodeV2(id 7, operator, pubkey, (ed25519, sig1, sig2, fee 25), [((operator, beneficiary), 100)])
+    std::string newNodeData = addressWord(OPERATOR) + PUBKEY_HEX + ED25519 + Uint256(0).toHex() + Uint256(0).toHex() + Uint256(25).toHex() + Uint256(8 * 32).toHex() +
+                              Uint256(1).toHex() + addressWord(OPERATOR) + addressWord(BENEFICIARY) + Uint256(100).toHex();
+    std::optional<ContractEvent> added = ContractEvent::decode(makeLog(ContractEvent::NEW_SERVICE_NODE_V2, Uint256(7).toHex(), newNodeData, 0x10, 3));
+    REQUIRE(added);
+    CHECK(added->blockNumber == 0x10);
+    CHECK(added->logIndex == 3);
+
+    const NewServiceNodeEvent& node = std::get<NewServiceNodeEvent>(added->data);
+    CHECK(node.serviceNodeID == 7);
+    CHECK(oxenc::to_hex(node.initiator.begin(), node.initiator.end()) == OPERATOR);
+    CHECK(utils::BLSPublicKeyToHex(node.pubkey) == PUBKEY_HEX);
+    CHECK(oxenc::to_hex(node.ed25519Pubkey.begin(), node.ed25519Pubkey.end()) == ED25519);
+    CHECK(node.fee == 25);
+    REQUIRE(node.contributors.size() == 1);
+    CHECK(oxenc::to_hex(node.contributors[0].beneficiaryAddress.begin(), node.contributors[0].beneficiaryAddress.end()) == BENEFICIARY);
+    CHECK(node.contributors[0].amount == 100);
+
+    std::optional<ContractEvent> updated = ContractEvent::decode(makeLog(ContractEvent::REWARDS_BALANCE_UPDATED, addressWord(BENEFICIARY), Uint256(500).toHex() + Uint256(200).toHex(), 0x11, 0));
+    REQUIRE(updated);
+    CHECK(std::get<RewardsBalanceUpdatedEvent>(updated->data).amount == 500);
+    CHECK(std::get<RewardsBalanceUpdatedEvent>(updated->data).previousBalance == 200);
+
+    // NOTE: Configuration events are not decoded
+    CHECK_FALSE(ContractEvent::decode(makeLog(EventTopic{"ClaimCycleUpdated(uint256)"}, Uint256(0).toHex(), Uint256(1).toHex(), 0x12, 0)));
+
+    // NOTE: Truncated data
+    CHECK_THROWS(ContractEvent::decode(makeLog(ContractEvent::REWARDS_BALANCE_UPDATED, addressWord(BENEFICIARY), Uint256(500).toHex(), 0x11, 0)));
+}
+
+TEST_CASE("Contract events are applied to the state mirror", "[events]") {
+    std::string newNodeData = addressWord(OPERATOR) + PUBKEY_HEX + ED25519 + Uint256(0).toHex() + Uint256(0).toHex() + Uint256(25).toHex() + Uint256(8 * 32).toHex() + Uint256(0).toHex();
+    std::string pubkeyData  = addressWord(OPERATOR) + PUBKEY_HEX;
+
+    ContractStateMirror mirror;
+    for (uint64_t id = 1; id <= 3; id++)
+        mirror.apply(*ContractEvent::decode(makeLog(ContractEvent::NEW_SERVICE_NODE_V2, Uint256(id).toHex(), newNodeData, id, 0)));
+    mirror.apply(*ContractEvent::decode(makeLog(ContractEvent::SERVICE_NODE_EXIT_REQUEST, Uint256(1).toHex(), pubkeyData, 4, 0)));
+    mirror.apply(*ContractEvent::decode(makeLog(ContractEvent::SERVICE_NODE_LIQUIDATED, Uint256(2).toHex(), pubkeyData, 5, 0)));
+    mirror.apply(*ContractEvent::decode(makeLog(ContractEvent::REWARDS_BALANCE_UPDATED, addressWord(BENEFICIARY), Uint256(500).toHex() + Uint256(0).toHex(), 6, 0)));
+    mirror.apply(*ContractEvent::decode(makeLog(ContractEvent::REWARDS_CLAIMED, addressWord(BENEFICIARY), Uint256(300).toHex(), 7, 0)));
+
+    REQUIRE(mirror.nodes.size() == 2);
+    CHECK(mirror.nodes.begin()->first == 1);
+    CHECK(mirror.nodes.at(1).leaveRequested);
+    CHECK_FALSE(mirror.nodes.at(3).leaveRequested);
+
+    mirror.apply(*ContractEvent::decode(makeLog(ContractEvent::SERVICE_NODE_EXIT, Uint256(1).toHex(), addressWord(OPERATOR) + Uint256(100).toHex() + PUBKEY_HEX, 8, 0)));
+    REQUIRE(mirror.nodes.size() == 1);
+    CHECK(mirror.nodes.begin()->first == 3);
+
+    REQUIRE(mirror.recipients.size() == 1);
+    const Recipient& recipient = mirror.recipients.begin()->second;
+    CHECK(recipient.rewards == 500);
+    CHECK(recipient.claimed == 300);
+}
+
+TEST_CASE("Contract event syncer resumes from the checkpoint it is given", "[events]") {
+    // NOTE: The checkpoint is only persisted with the mirror as a snapshot's
+    // block height, a new syncer starts from `startBlock`
+    ContractEventSyncer syncer{"http://127.0.0.1:8545", "0x5fc8d32690cc91d4c39d9d3abcbd16989f875707", 100};
+    CHECK_FALSE(syncer.checkpoint());
+    syncer.setCheckpoint(5678);
+    CHECK(syncer.checkpoint() == 5678);
+}
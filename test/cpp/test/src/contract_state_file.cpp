@@ -0,0 +1,84 @@
+#include <filesystem>
+#include <fstream>
+
+#include "service_node_rewards/contract_state_file.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_all.hpp>
+
+// NOTE: The generator of G1, (1, 2), is a valid BLS public key
+static bls::PublicKey generatorPubkey() {
+    std::array<uint8_t, 64> bytes = {};
+    bytes[31]                     = 1;
+    bytes[63]                     = 2;
+    return utils::BytesToBLSPublicKey(bytes);
+}
+
+TEST_CASE("Contract state snapshot round trips through the file", "[snapshot]") {
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "service_node_rewards_state_test";
+
+    ContractStateMirror mirror;
+    for (uint64_t id : {uint64_t{2}, uint64_t{5}, uint64_t{9}}) {
+        MirroredServiceNode& node = mirror.nodes[id];
+        node.pubkey               = generatorPubkey();
+        node.ed25519Pubkey.fill(static_cast<unsigned char>(id));
+        node.operatorAddress.fill(0xaa);
+        node.fee            = static_cast<uint16_t>(id * 100);
+        node.leaveRequested = id == 5;
+        for (uint64_t i = 0; i < id % 3; i++) {
+            Contributor contributor = {};
+            contributor.address.fill(static_cast<unsigned char>(i));
+            contributor.beneficiaryAddress.fill(0xbb);
+            contributor.amount = id * 1000 + i;
+            node.contributors.push_back(contributor);
+        }
+    }
+    std::array<unsigned char, 20> recipientAddress = {};
+    recipientAddress.fill(0xcc);
+    mirror.recipients.try_emplace(recipientAddress, 500, 300);
+
+    ContractStateFile::write(path, mirror, generatorPubkey(), 1234);
+    {
+        ContractStateFile file{path};
+        CHECK(file.header().blockHeight == 1234);
+        CHECK(utils::BLSPublicKeyToHex(file.aggregatePubkey()) == utils::BLSPublicKeyToHex(generatorPubkey()));
+
+        // NOTE: The linked list is stored in ID order
+        REQUIRE(file.nodes().size() == 3);
+        CHECK(file.nodes()[0].prev == 0);
+        CHECK(file.nodes()[0].next == 5);
+        CHECK(file.nodes()[1].prev == 2);
+        CHECK(file.nodes()[1].next == 9);
+        CHECK(file.nodes()[2].next == 0);
+        CHECK(file.contributors().size() == 2 + 2 + 0);
+
+        ContractStateMirror loaded = file.toMirror();
+        REQUIRE(loaded.nodes.size() == mirror.nodes.size());
+        for (const auto& [id, node] : mirror.nodes) {
+            const MirroredServiceNode& other = loaded.nodes.at(id);
+            CHECK(utils::BLSPublicKeyToHex(other.pubkey) == utils::BLSPublicKeyToHex(node.pubkey));
+            CHECK(other.ed25519Pubkey == node.ed25519Pubkey);
+            CHECK(other.operatorAddress == node.operatorAddress);
+            CHECK(other.fee == node.fee);
+            CHECK(other.leaveRequested == node.leaveRequested);
+            REQUIRE(other.contributors.size() == node.contributors.size());
+            for (size_t i = 0; i < node.contributors.size(); i++) {
+                CHECK(other.contributors[i].address == node.contributors[i].address);
+                CHECK(other.contributors[i].beneficiaryAddress == node.contributors[i].beneficiaryAddress);
+                CHECK(other.contributors[i].amount == node.contributors[i].amount);
+            }
+        }
+
+        REQUIRE(loaded.recipients.size() == 1);
+        CHECK(loaded.recipients.at(recipientAddress).rewards == 500);
+        CHECK(loaded.recipients.at(recipientAddress).claimed == 300);
+    }
+
+    // NOTE: Truncated and foreign files are rejected
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    CHECK_THROWS(ContractStateFile{path});
+    std::ofstream{path, std::ios::trunc} << "not a snapshot, just some text that is long enough to hold a header of 112 bytes ................................................";
+    CHECK_THROWS(ContractStateFile{path});
+    std::filesystem::remove(path);
+    CHECK_THROWS(ContractStateFile{path});
+}
@@ -0,0 +1,64 @@
+#include <array>
+
+#include "service_node_rewards/json_rpc_batch.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_all.hpp>
+
+TEST_CASE("JSON-RPC batch responses are matched to their requests by id", "[json rpc]") {
+    // NOTE: Nodes may answer a batch out of order
+    const std::string_view body = R"([
+        {"jsonrpc": "2.0", "id": 12, "result": "0x03"},
+        {"jsonrpc": "2.0", "id": 10, "result": "0x01"},
+        {"jsonrpc": "2.0", "id": 11, "result": "0x02"}
+    ])";
+
+    std::array<nlohmann::json, 3> results;
+    JsonRpcBatch::parseResponse(body, 10, results);
+    CHECK(results[0] == "0x01");
+    CHECK(results[1] == "0x02");
+    CHECK(results[2] == "0x03");
+}
+
+TEST_CASE("JSON-RPC batch errors are reported", "[json rpc]") {
+    std::array<nlohmann::json, 2> results;
+
+    // NOTE: An error in any of the requests fails the batch
+    CHECK_THROWS(JsonRpcBatch::parseResponse(R"([
+        {"jsonrpc": "2.0", "id": 1, "result": "0x01"},
+        {"jsonrpc": "2.0", "id": 2, "error": {"code": -32000, "message": "execution reverted"}}
+    ])", 1, results));
+
+    // NOTE: Missing and unexpected responses
+    CHECK_THROWS(JsonRpcBatch::parseResponse(R"([{"jsonrpc": "2.0", "id": 1, "result": "0x01"}])", 1, results));
+    CHECK_THROWS(JsonRpcBatch::parseResponse(R"([
+        {"jsonrpc": "2.0", "id": 1, "result": "0x01"},
+        {"jsonrpc": "2.0", "id": 3, "result": "0x03"}
+    ])", 1, results));
+
+    // NOTE: Batch rejected outright
+    CHECK_THROWS(JsonRpcBatch::parseResponse(R"({"jsonrpc": "2.0", "id": null, "error": {"code": -32600, "message": "batch too large"}})", 1, results));
+}
+
+TEST_CASE("JSON-RPC batch errors can be collected per request", "[json rpc]") {
+    std::array<nlohmann::json, 2> results;
+    std::array<nlohmann::json, 2> errors;
+    JsonRpcBatch::parseResponse(R"([
+        {"jsonrpc": "2.0", "id": 2, "error": {"code": -32000, "message": "nonce too low"}},
+        {"jsonrpc": "2.0", "id": 1, "result": "0x01"}
+    ])", 1, results, errors);
+    CHECK(results[0] == "0x01");
+    CHECK(errors[0].is_null());
+    CHECK(results[1].is_null());
+    CHECK(errors[1]["message"] == "nonce too low");
+
+    // NOTE: Missing responses still fail the batch
+    CHECK_THROWS(JsonRpcBatch::parseResponse(R"([{"jsonrpc": "2.0", "id": 1, "result": "0x01"}])", 1, results, errors));
+}
+
+TEST_CASE("JSON-RPC batch queues requests in order", "[json rpc]") {
+    JsonRpcBatch batch{"http://127.0.0.1:8545"};
+    CHECK(batch.ethCall("0x5FC8d32690cc91D4c39d9d3abcBD16989F875707", "0x70a08231") == 0);
+    CHECK(batch.request("eth_blockNumber", nlohmann::json::array()) == 1);
+    CHECK(batch.size() == 2);
+}
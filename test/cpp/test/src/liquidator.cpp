@@ -0,0 +1,187 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ethyl/signer.hpp"
+#include "ethyl/utils.hpp"
+#include "service_node_rewards/liquidator.hpp"
+#include "service_node_rewards/oxend_rpc.hpp"
+#include "service_node_rewards/rpc_provider.hpp"
+#include "service_node_rewards/service_node_list.hpp"
+#include "service_node_rewards/service_node_rewards_contract.hpp"
+#include "service_node_rewards/uint256.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_all.hpp>
+
+static const std::string REWARDS_ADDRESS = "0x5FC8d32690cc91D4c39d9d3abcBD16989F875707";
+static const uint32_t    CHAIN_ID        = 31337;
+
+// NOTE: Hardhat's first debug account, the liquidations are only signed and
+// handed to the pipeline's stubbed transport
+static const std::string SECRET_KEY = "ac0974bec39a17e36ba4a6b4d238ff944bacb478cbed5efcae784d7bf4f2ff80";
+
+// NOTE: ABI encoded return value of `allServiceNodeIDs` for the nodes `ids` of `snl`
+static std::string allServiceNodeIDs(const ServiceNodeList& snl, const std::vector<uint64_t>& ids) {
+    std::string result = "0x" + Uint256(0x40).toHex() + Uint256(0x40 + 32 * (1 + ids.size())).toHex() + Uint256(ids.size()).toHex();
+    for (uint64_t id : ids)
+        result += Uint256(id).toHex();
+    result += Uint256(ids.size()).toHex();
+    for (uint64_t id : ids)
+        result += snl.nodes[static_cast<size_t>(snl.findNodeIndex(id))].getPublicKeyHex();
+    return result;
+}
+
+TEST_CASE("Liquidator liquidates the nodes oxend reports as liquidatable", "[liquidator]") {
+    ServiceNodeList snl(5, 1);
+    MockOxend       oxend{snl, CHAIN_ID, REWARDS_ADDRESS};
+    oxend.height             = 100;
+    oxend.timestamp          = std::chrono::system_clock::time_point{std::chrono::seconds(1'700'000'000)};
+    oxend.liquidationHeights = {{2, 90}, {3, 95}, {4, 100}, {5, 200}};
+
+    // NOTE: Node 3 has already left the contract
+    const std::vector<uint64_t> registered = {1, 2, 4, 5};
+    auto                        replay     = std::make_shared<ReplayRpcProvider>();
+    ServiceNodeRewardsContract  contract;
+    contract.contractAddress = REWARDS_ADDRESS;
+    contract.rpc             = replay;
+
+    Liquidator liquidator{contract, oxend, /*pipeline*/ nullptr, 2};
+
+    // NOTE: Nodes 2 and 4 are liquidatable, 3 is not registered and 5 is not
+    // yet liquidatable
+    replay->add(REWARDS_ADDRESS, ServiceNodeRewardsContract::ALL_SERVICE_NODE_IDS.view(), allServiceNodeIDs(snl, registered));
+    Liquidator::Round round = liquidator.liquidate();
+    CHECK(round.heightChanged);
+    CHECK(round.height == 100);
+    CHECK(round.candidates == 4);
+    CHECK(round.skipped == 2);
+    REQUIRE(round.liquidations.size() == 2);
+
+    const uint64_t liquidated[] = {2, 4};
+    for (size_t i = 0; i < round.liquidations.size(); i++) {
+        const Liquidator::Liquidation& liquidation = round.liquidations[i];
+        INFO(liquidation.error);
+        REQUIRE(liquidation.error.empty());
+        CHECK(liquidation.candidate.serviceNodePubkey == MockOxend::serviceNodePubkey(liquidated[i]));
+        CHECK(liquidation.candidate.liquidationHeight == oxend.liquidationHeights[liquidated[i]]);
+
+        // NOTE: Only node 1 is not in the liquidation list and signs
+        const std::vector<uint64_t> signers = {1};
+        auto [pubkey, timestamp, sig]       = snl.exitNodeFromIndices(liquidated[i], CHAIN_ID, REWARDS_ADDRESS, signers, oxend.timestamp, /*liquidate*/ true);
+        CHECK(liquidation.candidate.blsPubkey == pubkey);
+        CHECK(liquidation.tx.to == REWARDS_ADDRESS);
+        CHECK(liquidation.tx.data == contract.liquidateBLSPublicKeyWithSignature(pubkey, timestamp, sig, {2, 3, 4, 5}).data);
+    }
+
+    // NOTE: Nothing is done until oxend's height advances
+    round = liquidator.liquidate();
+    CHECK_FALSE(round.heightChanged);
+    CHECK(round.liquidations.empty());
+
+    // NOTE: A dry run sends nothing, so nothing is pending and the same
+    // liquidations are built again once the height advances
+    oxend.height = 101;
+    replay->add(REWARDS_ADDRESS, ServiceNodeRewardsContract::ALL_SERVICE_NODE_IDS.view(), allServiceNodeIDs(snl, registered));
+    round = liquidator.liquidate();
+    CHECK(round.heightChanged);
+    CHECK(round.skipped == 2);
+    CHECK(round.liquidations.size() == 2);
+}
+
+TEST_CASE("Liquidator does not resubmit liquidations that are pending", "[liquidator]") {
+    ServiceNodeList snl(3, 1);
+    MockOxend       oxend{snl, CHAIN_ID, REWARDS_ADDRESS};
+    oxend.height             = 10;
+    oxend.liquidationHeights = {{2, 10}};
+
+    const std::vector<uint64_t> registered = {1, 2, 3};
+    auto                        replay     = std::make_shared<ReplayRpcProvider>();
+    ServiceNodeRewardsContract  contract;
+    contract.contractAddress = REWARDS_ADDRESS;
+    contract.rpc             = replay;
+
+    // NOTE: Stands in for the node, every transaction is accepted but never mined
+    ethyl::Signer       signer;
+    TransactionPipeline pipeline{signer, ethyl::utils::fromHexString(SECRET_KEY), "http://127.0.0.1:8545"};
+    size_t              sent = 0;
+    pipeline.transport       = [&sent](const std::string& body) {
+        nlohmann::json responses = nlohmann::json::array();
+        for (const nlohmann::json& request : nlohmann::json::parse(body)) {
+            const std::string method = request.at("method").get<std::string>();
+            nlohmann::json    result = "0x1";
+            if (method == "eth_feeHistory")
+                result = {{"baseFeePerGas", {"0x1", "0x1"}}};
+            else if (method == "eth_sendRawTransaction")
+                result = "0x" + std::string(63, '0') + std::to_string(++sent);
+            else if (method == "eth_getTransactionReceipt")
+                result = nullptr;
+            responses.push_back({{"jsonrpc", "2.0"}, {"id", request.at("id")}, {"result", std::move(result)}});
+        }
+        return responses.dump();
+    };
+
+    Liquidator liquidator{contract, oxend, &pipeline};
+    liquidator.submitTimeout = std::chrono::milliseconds(0);
+
+    replay->add(REWARDS_ADDRESS, ServiceNodeRewardsContract::ALL_SERVICE_NODE_IDS.view(), allServiceNodeIDs(snl, registered));
+    Liquidator::Round round = liquidator.liquidate();
+    REQUIRE(round.liquidations.size() == 1);
+    CHECK_FALSE(round.liquidations[0].result.hash.empty());
+    CHECK_FALSE(round.liquidations[0].error.empty());
+    CHECK(sent == 1);
+
+    // NOTE: The accepted transaction may still be mined, the node is skipped
+    // whilst it remains in the contract
+    oxend.height = 11;
+    replay->add(REWARDS_ADDRESS, ServiceNodeRewardsContract::ALL_SERVICE_NODE_IDS.view(), allServiceNodeIDs(snl, registered));
+    round = liquidator.liquidate();
+    CHECK(round.skipped == 1);
+    CHECK(round.liquidations.empty());
+    CHECK(sent == 1);
+
+    // NOTE: Pending liquidations are retried once they time out
+    liquidator.pendingTimeout = std::chrono::milliseconds(0);
+    oxend.height              = 12;
+    replay->add(REWARDS_ADDRESS, ServiceNodeRewardsContract::ALL_SERVICE_NODE_IDS.view(), allServiceNodeIDs(snl, registered));
+    round = liquidator.liquidate();
+    CHECK(round.skipped == 0);
+    CHECK(round.liquidations.size() == 1);
+    CHECK(sent == 2);
+}
+
+TEST_CASE("Liquidator reports the nodes oxend refuses to sign", "[liquidator]") {
+    ServiceNodeList snl(3, 1);
+    MockOxend       oxend{snl, CHAIN_ID, REWARDS_ADDRESS};
+    oxend.height             = 10;
+    oxend.liquidationHeights = {{3, 10}};
+
+    auto                       replay = std::make_shared<ReplayRpcProvider>();
+    ServiceNodeRewardsContract contract;
+    contract.contractAddress = REWARDS_ADDRESS;
+    contract.rpc             = replay;
+    replay->add(REWARDS_ADDRESS, ServiceNodeRewardsContract::ALL_SERVICE_NODE_IDS.view(), allServiceNodeIDs(snl, {1, 2, 3}));
+
+    // NOTE: Node 3 leaves oxend's list after the list was read, the signature
+    // request is refused
+    struct RacingOxend : OxendRpc {
+        nlohmann::json request(std::string_view method, const nlohmann::json& params) override {
+            if (method == "bls_exit_liquidation_request")
+                mock.liquidationHeights.clear();
+            return mock.request(method, params);
+        }
+        MockOxend& mock;
+        explicit RacingOxend(MockOxend& _mock) : mock(_mock) {}
+    } racing{oxend};
+
+    Liquidator        liquidator{contract, racing, /*pipeline*/ nullptr};
+    Liquidator::Round round = liquidator.liquidate();
+    REQUIRE(round.liquidations.size() == 1);
+    CHECK(round.liquidations[0].tx.data.empty());
+    CHECK_THAT(round.liquidations[0].error, Catch::Matchers::ContainsSubstring("not in the exit or liquidation list"));
+
+    // NOTE: Unsupported methods are reported the same way as oxend
+    nlohmann::json response = oxend.request("get_service_nodes");
+    REQUIRE(response.contains("error"));
+    CHECK(response["error"]["code"] == -32601);
+}
@@ -0,0 +1,56 @@
+#include <string>
+
+#include "service_node_rewards/multicall.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_all.hpp>
+
+static_assert(Multicall3::AGGREGATE3.view() == "0x82ad56cb");
+
+TEST_CASE("Multicall3 encodes aggregate3 call data", "[multicall]") {
+    Multicall3 multicall{"0xcA11bde05977b3631167028862bE2a173976CA11"};
+    CHECK(multicall.add("0x5fc8d32690cc91d4c39d9d3abcbd16989f875707", "0x12345678" + std::string(62, '0') + "01") == 0);
+    CHECK(multicall.add("0x70997970c51812dc3a010c7d01b50e0d17dc79c8", "0xabcdef01", /*allowFailure*/ true) == 1);
+
+    // NOTE: Generated with eth_abi, encode(['(address,bool,bytes)[]'], [calls])
+    const std::string expected = "0x82ad56cb"
+            "0000000000000000000000000000000000000000000000000000000000000020"
+            "0000000000000000000000000000000000000000000000000000000000000002"
+            "0000000000000000000000000000000000000000000000000000000000000040"
+            "0000000000000000000000000000000000000000000000000000000000000100"
+            "0000000000000000000000005fc8d32690cc91d4c39d9d3abcbd16989f875707"
+            "0000000000000000000000000000000000000000000000000000000000000000"
+            "0000000000000000000000000000000000000000000000000000000000000060"
+            "0000000000000000000000000000000000000000000000000000000000000024"
+            "1234567800000000000000000000000000000000000000000000000000000000"
+            "0000000100000000000000000000000000000000000000000000000000000000"
+            "00000000000000000000000070997970c51812dc3a010c7d01b50e0d17dc79c8"
+            "0000000000000000000000000000000000000000000000000000000000000001"
+            "0000000000000000000000000000000000000000000000000000000000000060"
+            "0000000000000000000000000000000000000000000000000000000000000004"
+            "abcdef0100000000000000000000000000000000000000000000000000000000";
+    CHECK(multicall.encode() == expected);
+}
+
+TEST_CASE("Multicall3 decodes the aggregate3 results", "[multicall]") {
+    // NOTE: Generated with eth_abi, encode(['(bool,bytes)[]'], [[(True, uint256(42)), (False, b'')]])
+    const std::string returned = "0x"
+            "0000000000000000000000000000000000000000000000000000000000000020"
+            "0000000000000000000000000000000000000000000000000000000000000002"
+            "0000000000000000000000000000000000000000000000000000000000000040"
+            "00000000000000000000000000000000000000000000000000000000000000c0"
+            "0000000000000000000000000000000000000000000000000000000000000001"
+            "0000000000000000000000000000000000000000000000000000000000000040"
+            "0000000000000000000000000000000000000000000000000000000000000020"
+            "000000000000000000000000000000000000000000000000000000000000002a"
+            "0000000000000000000000000000000000000000000000000000000000000000"
+            "0000000000000000000000000000000000000000000000000000000000000040"
+            "0000000000000000000000000000000000000000000000000000000000000000";
+
+    std::vector<Multicall3::Result> results = Multicall3::decode(returned);
+    REQUIRE(results.size() == 2);
+    CHECK(results[0].success);
+    CHECK(results[0].returnData == std::string(62, '0') + "2a");
+    CHECK_FALSE(results[1].success);
+    CHECK(results[1].returnData.empty());
+}
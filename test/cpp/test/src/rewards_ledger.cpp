@@ -0,0 +1,104 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "service_node_rewards/config.hpp"
+#include "service_node_rewards/multicall.hpp"
+#include "service_node_rewards/rewards_ledger.hpp"
+#include "service_node_rewards/rpc_provider.hpp"
+#include "service_node_rewards/service_node_list.hpp"
+#include "service_node_rewards/service_node_rewards_contract.hpp"
+#include "service_node_rewards/uint256.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_all.hpp>
+
+static const std::string REWARDS_ADDRESS = "0x5FC8d32690cc91D4c39d9d3abcBD16989F875707";
+static const uint32_t    CHAIN_ID        = 31337;
+
+// NOTE: Recipients in the ledger's (address) order
+static const std::string ALICE = "0x1111111111111111111111111111111111111111";
+static const std::string BOB   = "0x2222222222222222222222222222222222222222";
+static const std::string CAROL = "0x3333333333333333333333333333333333333333";
+static const std::string DAVE  = "0x4444444444444444444444444444444444444444";
+
+// NOTE: ABI encoded return value of `aggregate3` where every call succeeded
+// and returned the 2 words of a `recipients(address)`
+static std::string aggregate3Result(const std::vector<std::string>& returnData) {
+    const size_t TUPLE_SIZE = 5 * 32; // NOTE: success, offset, length and 2 words of data
+    std::string  result     = "0x" + Uint256(0x20).toHex() + Uint256(returnData.size()).toHex();
+    for (size_t i = 0; i < returnData.size(); i++)
+        result += Uint256(returnData.size() * 32 + i * TUPLE_SIZE).toHex();
+    for (const std::string& data : returnData)
+        result += Uint256(1).toHex() + Uint256(0x40).toHex() + Uint256(64).toHex() + data;
+    return result;
+}
+
+// NOTE: Queue the contract's (rewards, claimed) of `recipients` to be returned
+// for an aggregate3 call that reads them
+static void addRecipients(ReplayRpcProvider& replay, const std::vector<std::pair<std::string, std::string>>& recipients) {
+    Multicall3               multicall{std::string(ethbls::config::MULTICALL3_ADDRESS)};
+    std::vector<std::string> returnData;
+    for (const auto& [address, data] : recipients) {
+        multicall.add(REWARDS_ADDRESS, ServiceNodeRewardsContract::recipientsCallData(address));
+        returnData.push_back(data);
+    }
+    replay.add(ethbls::config::MULTICALL3_ADDRESS, multicall.encode(), aggregate3Result(returnData));
+}
+
+TEST_CASE("Rewards ledger signs the updates of the recipients that are owed more", "[rewards ledger]") {
+    ServiceNodeList            snl(4, 2);
+    auto                       replay = std::make_shared<ReplayRpcProvider>();
+    ServiceNodeRewardsContract contract;
+    contract.contractAddress = REWARDS_ADDRESS;
+    contract.rpc             = replay;
+
+    RewardsLedger ledger{snl, contract, CHAIN_ID};
+    ledger.readChunkSize = 2;
+    ledger.accrue(ALICE, 200);
+    ledger.accrue(ALICE, 300);
+    ledger.accrue(BOB, 300);
+    ledger.accrue(CAROL, 100);
+    ledger.accrue("0x" + std::string(40, '4'), Uint256::fromHex("400000000000000000")); // NOTE: 2^70, beyond 64 bits
+    CHECK(ledger.accrued(ALICE) == 500);
+    CHECK(ledger.accrued("0x5555555555555555555555555555555555555555") == 0);
+    CHECK_THROWS(ledger.accrue("0x1234", 1));
+
+    // NOTE: Alice is owed 300, Bob is settled, Carol was paid more than the
+    // ledger accrued and Dave has never been paid
+    addRecipients(*replay, {{ALICE, Uint256(200).toHex() + Uint256(50).toHex()}, {BOB, Uint256(300).toHex() + Uint256(300).toHex()}});
+    addRecipients(*replay, {{CAROL, Uint256(400).toHex() + Uint256(0).toHex()}, {DAVE, Uint256(0).toHex() + Uint256(0).toHex()}});
+
+    const std::vector<uint64_t> signers = {1, 2, 4};
+    Multicall3                  multicall{std::string(ethbls::config::MULTICALL3_ADDRESS)};
+    RewardsLedger::Batch        batch   = ledger.prepare(multicall, signers);
+    CHECK(batch.recipients() == 4);
+    CHECK(batch.unchanged == 1);
+    REQUIRE(batch.behind.size() == 1);
+    CHECK(batch.behind[0] == CAROL);
+    CHECK(batch.recipientsPerSecond() > 0);
+
+    REQUIRE(batch.updates.size() == 2);
+    CHECK(batch.updates[0].address == ALICE);
+    CHECK(batch.updates[0].onChainRewards == 200);
+    CHECK(batch.updates[0].delta() == 300);
+    CHECK(batch.updates[1].address == DAVE);
+    CHECK(batch.updates[1].delta() == Uint256::fromHex("400000000000000000"));
+
+    // NOTE: The updates are signed the same as one at a time
+    for (const RewardsLedger::Update& update : batch.updates) {
+        std::string signature = snl.updateRewardsBalance(update.address, update.accruedRewards, CHAIN_ID, REWARDS_ADDRESS, signers);
+        CHECK(update.tx.to == REWARDS_ADDRESS);
+        CHECK(update.tx.data == contract.updateRewardsBalance(update.address, update.accruedRewards, signature, {3}).data);
+    }
+
+    // NOTE: Per-node signing parallelises each signature on the list's pool
+    // instead, the updates must be identical
+    snl.signingMode = ServiceNodeList::SigningMode::PerNode;
+    addRecipients(*replay, {{ALICE, Uint256(200).toHex() + Uint256(50).toHex()}, {BOB, Uint256(300).toHex() + Uint256(300).toHex()}});
+    addRecipients(*replay, {{CAROL, Uint256(400).toHex() + Uint256(0).toHex()}, {DAVE, Uint256(0).toHex() + Uint256(0).toHex()}});
+    RewardsLedger::Batch perNode = ledger.prepare(multicall, signers);
+    REQUIRE(perNode.updates.size() == batch.updates.size());
+    for (size_t i = 0; i < batch.updates.size(); i++)
+        CHECK(perNode.updates[i].tx.data == batch.updates[i].tx.data);
+}
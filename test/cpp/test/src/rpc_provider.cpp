@@ -0,0 +1,72 @@
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "service_node_rewards/erc20_contract.hpp"
+#include "service_node_rewards/rpc_provider.hpp"
+#include "service_node_rewards/service_node_rewards_contract.hpp"
+#include "service_node_rewards/uint256.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_all.hpp>
+
+static const std::string REWARDS_ADDRESS = "0x5FC8d32690cc91D4c39d9d3abcBD16989F875707";
+static const std::string ERC20_ADDRESS   = "0x5FbDB2315678afecb367f032d93F642f64180aa3";
+static const std::string RECIPIENT       = "0x70997970C51812dc3A010C7d01b50e0d17dc79C8";
+
+// NOTE: Stands in for a node, every call returns a value that increases with
+// the number of calls made so a replay that returns responses out of order
+// is detected
+struct CountingRpcProvider : RpcProvider {
+    std::string ethCall(std::string_view address, std::string_view data) override {
+        calls++;
+        if (address == ERC20_ADDRESS)
+            return "0x" + Uint256(1000 * calls).toHex();
+        if (data == ServiceNodeRewardsContract::TOTAL_NODES.view())
+            return "0x" + Uint256(calls).toHex();
+        return "0x" + Uint256(10 * calls).toHex() + Uint256(calls).toHex(); // NOTE: recipients(address), (rewards, claimed)
+    }
+    uint64_t calls = 0;
+};
+
+TEST_CASE("Contract reads can be recorded and replayed", "[rpc]") {
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "service_node_rewards_rpc_recording_test.json";
+    std::filesystem::remove(path);
+
+    ServiceNodeRewardsContract rewards_contract;
+    ERC20Contract              erc20_contract;
+    rewards_contract.contractAddress = REWARDS_ADDRESS;
+    erc20_contract.contractAddress   = ERC20_ADDRESS;
+
+    // NOTE: Record
+    auto recorder        = std::make_shared<ReplayRpcProvider>(std::make_shared<CountingRpcProvider>());
+    rewards_contract.rpc = recorder;
+    erc20_contract.rpc   = recorder;
+    CHECK(rewards_contract.totalNodes() == 1);
+    CHECK(rewards_contract.viewRecipientData(RECIPIENT).rewards == 20);
+    CHECK(erc20_contract.balanceOf(RECIPIENT) == 3000);
+    CHECK(rewards_contract.totalNodes() == 4);
+    recorder->save(path);
+
+    // NOTE: Replay, without an upstream provider. Addresses are matched
+    // regardless of their checksum casing.
+    auto replayer                  = std::make_shared<ReplayRpcProvider>(ReplayRpcProvider::load(path));
+    rewards_contract.rpc           = replayer;
+    erc20_contract.rpc             = replayer;
+    erc20_contract.contractAddress = "0x5fbdb2315678afecb367f032d93f642f64180aa3";
+    CHECK(erc20_contract.balanceOf(RECIPIENT) == 3000);
+    CHECK(rewards_contract.totalNodes() == 1);
+    CHECK(rewards_contract.totalNodes() == 4);
+
+    Recipient recipient = rewards_contract.viewRecipientData(RECIPIENT);
+    CHECK(recipient.rewards == 20);
+    CHECK(recipient.claimed == 2);
+
+    // NOTE: Every recorded response has been replayed
+    CHECK_THROWS(rewards_contract.totalNodes());
+    CHECK_THROWS(erc20_contract.balanceOf(REWARDS_ADDRESS));
+
+    std::ofstream{path, std::ios::trunc} << "{}";
+    CHECK_THROWS(ReplayRpcProvider::load(path));
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,178 @@
+#include <string>
+
+#include "service_node_rewards/config.hpp"
+#include "service_node_rewards/service_node_contribution_contract.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_all.hpp>
+
+static const std::string OPERATOR    = "70997970c51812dc3a010c7d01b50e0d17dc79c8";
+static const std::string BENEFICIARY = "3c44cdddb6a900fa2b585dd299e03d12fa4293bc";
+static const std::string CONTRIBUTOR = "90f79bf6eb2c4f870365e785982e1f101e93b906";
+
+static std::string hex(std::span<const unsigned char> bytes) {
+    return oxenc::to_hex(bytes.begin(), bytes.end());
+}
+
+TEST_CASE("Contribution contract transactions are encoded", "[contribution]") {
+    ServiceNodeContributionContract contract;
+    contract.contractAddress = "0x5FC8d32690cc91D4c39d9d3abcBD16989F875707";
+
+    // NOTE: Generated with eth_abi, encode(['uint256','address'], [100, beneficiary])
+    CHECK(contract.contributeFunds(100, "0x" + BENEFICIARY).data == std::string(ServiceNodeContributionContract::CONTRIBUTE_FUNDS.view()) +
+            "0000000000000000000000000000000000000000000000000000000000000064"
+            "0000000000000000000000003c44cdddb6a900fa2b585dd299e03d12fa4293bc");
+    CHECK(contract.finalize().data == ServiceNodeContributionContract::FINALIZE.view());
+
+    // NOTE: Generated with eth_abi, encode([G1, BLSSignatureParams, ServiceNodeParams, '(address,uint256)[]', 'bool', 'address', 'uint256'],
+    // [(1, 2), (3, 4, 5, 6), (ed25519, sig[:32], sig[32:], 25), [(contributor, 50)], True, beneficiary, 100])
+    std::string ed25519Pubkey(32, '\0'), ed25519Signature(64, '\0');
+    for (size_t i = 0; i < ed25519Pubkey.size(); i++)
+        ed25519Pubkey[i] = "\xd3\xc2\x08\xc1\x6d\x87\xcf\xd3"[i % 8];
+    for (size_t i = 0; i < ed25519Signature.size(); i++)
+        ed25519Signature[i] = static_cast<char>(i);
+
+    const ReservedContributor reserved[] = {{"0x" + CONTRIBUTOR, 50}};
+    ethyl::Transaction        tx         = contract.resetUpdateAndContribute(
+            "0000000000000000000000000000000000000000000000000000000000000001"
+            "0000000000000000000000000000000000000000000000000000000000000002",
+            "0000000000000000000000000000000000000000000000000000000000000003"
+            "0000000000000000000000000000000000000000000000000000000000000004"
+            "0000000000000000000000000000000000000000000000000000000000000005"
+            "0000000000000000000000000000000000000000000000000000000000000006",
+            ed25519Pubkey,
+            ed25519Signature,
+            25,
+            reserved,
+            /*manualFinalize*/ true,
+            "0x" + BENEFICIARY,
+            100);
+    CHECK(tx.data == std::string(ServiceNodeContributionContract::RESET_UPDATE_AND_CONTRIBUTE.view()) +
+            "0000000000000000000000000000000000000000000000000000000000000001"
+            "0000000000000000000000000000000000000000000000000000000000000002"
+            "0000000000000000000000000000000000000000000000000000000000000003"
+            "0000000000000000000000000000000000000000000000000000000000000004"
+            "0000000000000000000000000000000000000000000000000000000000000005"
+            "0000000000000000000000000000000000000000000000000000000000000006"
+            "d3c208c16d87cfd3d3c208c16d87cfd3d3c208c16d87cfd3d3c208c16d87cfd3"
+            "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+            "202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f"
+            "0000000000000000000000000000000000000000000000000000000000000019"
+            "00000000000000000000000000000000000000000000000000000000000001c0"
+            "0000000000000000000000000000000000000000000000000000000000000001"
+            "0000000000000000000000003c44cdddb6a900fa2b585dd299e03d12fa4293bc"
+            "0000000000000000000000000000000000000000000000000000000000000064"
+            "0000000000000000000000000000000000000000000000000000000000000001"
+            "00000000000000000000000090f79bf6eb2c4f870365e785982e1f101e93b906"
+            "0000000000000000000000000000000000000000000000000000000000000032");
+}
+
+TEST_CASE("Contribution contract views are decoded", "[contribution]") {
+    // NOTE: Generated with eth_abi, encode(['address[]','address[]','uint256[]'], [[operator, contributor], [beneficiary, contributor], [100, 200]])
+    std::vector<Contributor> contributors = ServiceNodeContributionContract::decodeContributions(
+            "0000000000000000000000000000000000000000000000000000000000000060"
+            "00000000000000000000000000000000000000000000000000000000000000c0"
+            "0000000000000000000000000000000000000000000000000000000000000120"
+            "0000000000000000000000000000000000000000000000000000000000000002"
+            "00000000000000000000000070997970c51812dc3a010c7d01b50e0d17dc79c8"
+            "00000000000000000000000090f79bf6eb2c4f870365e785982e1f101e93b906"
+            "0000000000000000000000000000000000000000000000000000000000000002"
+            "0000000000000000000000003c44cdddb6a900fa2b585dd299e03d12fa4293bc"
+            "00000000000000000000000090f79bf6eb2c4f870365e785982e1f101e93b906"
+            "0000000000000000000000000000000000000000000000000000000000000002"
+            "0000000000000000000000000000000000000000000000000000000000000064"
+            "00000000000000000000000000000000000000000000000000000000000000c8");
+    REQUIRE(contributors.size() == 2);
+    CHECK(hex(contributors[0].address) == OPERATOR);
+    CHECK(hex(contributors[0].beneficiaryAddress) == BENEFICIARY);
+    CHECK(contributors[0].amount == 100);
+    CHECK(hex(contributors[1].address) == CONTRIBUTOR);
+    CHECK(hex(contributors[1].beneficiaryAddress) == CONTRIBUTOR);
+    CHECK(contributors[1].amount == 200);
+
+    // NOTE: Generated with eth_abi, encode(['address[]','uint256[]','bool[]'], [[contributor], [50], [True]])
+    std::vector<ReservedContribution> reserved = ServiceNodeContributionContract::decodeReserved(
+            "0000000000000000000000000000000000000000000000000000000000000060"
+            "00000000000000000000000000000000000000000000000000000000000000a0"
+            "00000000000000000000000000000000000000000000000000000000000000e0"
+            "0000000000000000000000000000000000000000000000000000000000000001"
+            "00000000000000000000000090f79bf6eb2c4f870365e785982e1f101e93b906"
+            "0000000000000000000000000000000000000000000000000000000000000001"
+            "0000000000000000000000000000000000000000000000000000000000000032"
+            "0000000000000000000000000000000000000000000000000000000000000001"
+            "0000000000000000000000000000000000000000000000000000000000000001");
+    REQUIRE(reserved.size() == 1);
+    CHECK(hex(reserved[0].address) == CONTRIBUTOR);
+    CHECK(reserved[0].amount == 50);
+    CHECK(reserved[0].received);
+
+    // NOTE: The arrays are returned with different lengths
+    CHECK_THROWS(ServiceNodeContributionContract::decodeReserved(
+            "0000000000000000000000000000000000000000000000000000000000000060"
+            "00000000000000000000000000000000000000000000000000000000000000a0"
+            "00000000000000000000000000000000000000000000000000000000000000c0"
+            "0000000000000000000000000000000000000000000000000000000000000001"
+            "00000000000000000000000090f79bf6eb2c4f870365e785982e1f101e93b906"
+            "0000000000000000000000000000000000000000000000000000000000000000"
+            "0000000000000000000000000000000000000000000000000000000000000000"));
+
+    ServiceNodeParams params = ServiceNodeContributionContract::decodeServiceNodeParams(
+            "d3c208c16d87cfd3d3c208c16d87cfd3d3c208c16d87cfd3d3c208c16d87cfd3"
+            "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+            "202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f"
+            "0000000000000000000000000000000000000000000000000000000000000019");
+    CHECK(hex(params.ed25519Pubkey) == "d3c208c16d87cfd3d3c208c16d87cfd3d3c208c16d87cfd3d3c208c16d87cfd3");
+    CHECK(hex(params.ed25519Signature) == "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+                                          "202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f");
+    CHECK(params.fee == 25);
+}
+
+TEST_CASE("Contributions of many contribution contracts are read in one call", "[contribution]") {
+    const std::string addresses[] = {"0x5FC8d32690cc91D4c39d9d3abcBD16989F875707", "0x0165878A594ca255338adfa4d48449f69242Eb8F"};
+
+    Multicall3 expected{std::string(ethbls::config::MULTICALL3_ADDRESS)};
+    for (const std::string& address : addresses)
+        expected.add(address, std::string(ServiceNodeContributionContract::GET_CONTRIBUTIONS.view()));
+
+    // NOTE: Generated with eth_abi, the first contract has one contributor
+    // and the second has none
+    auto replay = std::make_shared<ReplayRpcProvider>();
+    replay->add(ethbls::config::MULTICALL3_ADDRESS, expected.encode(), "0x"
+            "0000000000000000000000000000000000000000000000000000000000000020"
+            "0000000000000000000000000000000000000000000000000000000000000002"
+            "0000000000000000000000000000000000000000000000000000000000000040"
+            "00000000000000000000000000000000000000000000000000000000000001c0"
+            "0000000000000000000000000000000000000000000000000000000000000001"
+            "0000000000000000000000000000000000000000000000000000000000000040"
+            "0000000000000000000000000000000000000000000000000000000000000120"
+            "0000000000000000000000000000000000000000000000000000000000000060"
+            "00000000000000000000000000000000000000000000000000000000000000a0"
+            "00000000000000000000000000000000000000000000000000000000000000e0"
+            "0000000000000000000000000000000000000000000000000000000000000001"
+            "00000000000000000000000070997970c51812dc3a010c7d01b50e0d17dc79c8"
+            "0000000000000000000000000000000000000000000000000000000000000001"
+            "0000000000000000000000003c44cdddb6a900fa2b585dd299e03d12fa4293bc"
+            "0000000000000000000000000000000000000000000000000000000000000001"
+            "0000000000000000000000000000000000000000000000000000000000000064"
+            "0000000000000000000000000000000000000000000000000000000000000001"
+            "0000000000000000000000000000000000000000000000000000000000000040"
+            "00000000000000000000000000000000000000000000000000000000000000c0"
+            "0000000000000000000000000000000000000000000000000000000000000060"
+            "0000000000000000000000000000000000000000000000000000000000000080"
+            "00000000000000000000000000000000000000000000000000000000000000a0"
+            "0000000000000000000000000000000000000000000000000000000000000000"
+            "0000000000000000000000000000000000000000000000000000000000000000"
+            "0000000000000000000000000000000000000000000000000000000000000000");
+
+    ServiceNodeContributionContract contract;
+    contract.rpc = replay;
+
+    Multicall3                            multicall{std::string(ethbls::config::MULTICALL3_ADDRESS)};
+    std::vector<std::vector<Contributor>> contributions = contract.getContributions(multicall, addresses);
+    REQUIRE(contributions.size() == 2);
+    REQUIRE(contributions[0].size() == 1);
+    CHECK(hex(contributions[0][0].address) == OPERATOR);
+    CHECK(hex(contributions[0][0].beneficiaryAddress) == BENEFICIARY);
+    CHECK(contributions[0][0].amount == 100);
+    CHECK(contributions[1].empty());
+}
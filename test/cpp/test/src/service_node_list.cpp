@@ -0,0 +1,293 @@
+#include "service_node_rewards/ec_utils.hpp"
+#include "service_node_rewards/service_node_list.hpp"
+#include "ethyl/utils.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_all.hpp>
+
+// NOTE: Arbitrary signing domain, these tests never touch a chain
+static constexpr uint32_t         CHAIN_ID         = 31337;
+static constexpr std::string_view CONTRACT_ADDRESS = "0x5FC8d32690cc91D4c39d9d3abcBD16989F875707";
+static const std::string          MESSAGE_HEX      = "0x0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef";
+
+TEST_CASE("Parallel signature aggregation matches serial aggregation", "[service node list]") {
+    ServiceNodeList snl(13, 1);
+    snl.signingMode = ServiceNodeList::SigningMode::PerNode;
+    const std::string serialSig = snl.aggregateSignatures(MESSAGE_HEX, CHAIN_ID, CONTRACT_ADDRESS);
+    const auto        signers   = snl.randomSigners(9);
+    const auto serialExitSig    = std::get<2>(snl.exitNodeFromIndices(signers[0], CHAIN_ID, std::string(CONTRACT_ADDRESS), signers, std::chrono::system_clock::time_point{}));
+    CHECK_FALSE(snl.signingPool);
+
+    for (size_t threads : std::initializer_list<size_t>{2, 3, 4, 8, 32}) {
+        INFO("Signing with " << threads << " threads");
+        snl.signingPool = std::make_shared<WorkerPool>(threads);
+        CHECK(snl.aggregateSignatures(MESSAGE_HEX, CHAIN_ID, CONTRACT_ADDRESS) == serialSig);
+        CHECK(std::get<2>(snl.exitNodeFromIndices(signers[0], CHAIN_ID, std::string(CONTRACT_ADDRESS), signers, std::chrono::system_clock::time_point{})) == serialExitSig);
+    }
+}
+
+TEST_CASE("Signing pool is only created for per-node aggregation", "[service node list]") {
+    ServiceNodeList snl(3, 2);
+    const std::string summed = snl.aggregateSignatures(MESSAGE_HEX, CHAIN_ID, CONTRACT_ADDRESS);
+    CHECK_FALSE(snl.signingPool);
+
+    snl.signingMode = ServiceNodeList::SigningMode::PerNode;
+    CHECK(snl.aggregateSignatures(MESSAGE_HEX, CHAIN_ID, CONTRACT_ADDRESS) == summed);
+    REQUIRE(snl.signingPool);
+    CHECK(snl.signingPool->size() == 2);
+
+    // NOTE: An assigned pool is shared rather than replaced
+    auto shared     = std::make_shared<WorkerPool>(3);
+    snl.signingPool = shared;
+    CHECK(snl.aggregateSignatures(MESSAGE_HEX, CHAIN_ID, CONTRACT_ADDRESS) == summed);
+    CHECK(snl.workerPool() == shared);
+}
+
+TEST_CASE("Signing a prepared message matches signing the raw message", "[service node list]") {
+    ServiceNodeList             snl(3, 1);
+    const std::vector<uint8_t>  message  = {0xde, 0xad, 0xbe, 0xef};
+    const PreparedMessage       prepared = PreparedMessage::prepare(message, CHAIN_ID, CONTRACT_ADDRESS);
+    for (const auto& node : snl.nodes) {
+        CHECK(utils::SignatureToHex(node.signPrepared(prepared)) ==
+              utils::SignatureToHex(node.blsSignHash(message, CHAIN_ID, CONTRACT_ADDRESS)));
+    }
+}
+
+TEST_CASE("Cached domain tags sign identically to deriving tags per call", "[service node list]") {
+    ServiceNodeList            snl(4, 1);
+    const auto                 signers  = snl.randomSigners(3);
+    const std::vector<uint8_t> message  = {0xde, 0xad, 0xbe, 0xef};
+    const DomainTags           tags(CHAIN_ID, CONTRACT_ADDRESS);
+    const auto                 exitTime = std::chrono::system_clock::time_point{};
+
+    // NOTE: The cache normalises the address, differently cased spellings of
+    // the same contract must resolve to the same entry
+    const DomainTags& cached = snl.domainTags(CHAIN_ID, CONTRACT_ADDRESS);
+    CHECK(&snl.domainTags(CHAIN_ID, "0x5fc8d32690cc91d4c39d9d3abcbd16989f875707") == &cached);
+    CHECK(&snl.domainTags(CHAIN_ID + 1, CONTRACT_ADDRESS) != &cached);
+    CHECK(cached.exit == tags.exit);
+    CHECK(cached.reward != tags.exit);
+
+    const ServiceNode& node = snl.nodes[0];
+    CHECK(utils::SignatureToHex(node.blsSignHash(message, tags)) == utils::SignatureToHex(node.blsSignHash(message, CHAIN_ID, CONTRACT_ADDRESS)));
+    CHECK(snl.aggregateSignatures(MESSAGE_HEX, tags) == snl.aggregateSignatures(MESSAGE_HEX, CHAIN_ID, CONTRACT_ADDRESS));
+    CHECK(snl.exitNodeFromIndices(signers[0], tags, signers, exitTime) ==
+          snl.exitNodeFromIndices(signers[0], CHAIN_ID, std::string(CONTRACT_ADDRESS), signers, exitTime));
+    CHECK(snl.liquidateNodeFromIndices(signers[0], tags, signers, exitTime) ==
+          snl.liquidateNodeFromIndices(signers[0], CHAIN_ID, std::string(CONTRACT_ADDRESS), signers, exitTime));
+    CHECK(snl.updateRewardsBalance("0x1234567890123456789012345678901234567890", 1000, tags, signers) ==
+          snl.updateRewardsBalance("0x1234567890123456789012345678901234567890", 1000, CHAIN_ID, std::string(CONTRACT_ADDRESS), signers));
+    CHECK(snl.nodes[1].proofOfPossession(tags, "0x1234567890123456789012345678901234567890", "pubkey") ==
+          snl.nodes[1].proofOfPossession(CHAIN_ID, std::string(CONTRACT_ADDRESS), "0x1234567890123456789012345678901234567890", "pubkey"));
+}
+
+TEST_CASE("Binary message builder matches the hex encoded message layout", "[service node list]") {
+    ServiceNodeList   snl(1, 1);
+    const DomainTags  tags(CHAIN_ID, CONTRACT_ADDRESS);
+    const std::string address    = "0x1234567890123456789012345678901234567890";
+    const std::string pubkeyHex  = snl.nodes[0].getPublicKeyHex();
+    const uint64_t    amount     = 0x0102030405060708;
+
+    MessageBuilder message;
+    message.append(tags.reward).append(utils::BLSPublicKeyToBytes(snl.nodes[0].getPublicKey())).appendAddress(address).appendU256(amount);
+
+    const std::string expected = oxenc::to_hex(tags.reward.begin(), tags.reward.end()) + pubkeyHex + address.substr(2) +
+                                 ethyl::utils::padTo32Bytes(ethyl::utils::decimalToHex(amount), ethyl::utils::PaddingDirection::LEFT);
+    CHECK(oxenc::to_hex(message.bytes().begin(), message.bytes().end()) == expected);
+
+    // NOTE: Short addresses and payloads are left padded
+    MessageBuilder padded;
+    const std::vector<uint8_t> payload = {0xab, 0xcd};
+    padded.appendAddress("0xff").appendLeftPadded(payload, 4);
+    CHECK(oxenc::to_hex(padded.bytes().begin(), padded.bytes().end()) == std::string(38, '0') + "ff" + "0000abcd");
+
+    // NOTE: Overflowing the builder must throw rather than truncate
+    MessageBuilder full;
+    const std::array<uint8_t, MessageBuilder::CAPACITY> filler = {};
+    full.append(filler);
+    CHECK_THROWS(full.appendU256(0));
+    CHECK_THROWS(MessageBuilder{}.appendAddress("0x" + std::string(42, 'a')));
+    CHECK_THROWS(MessageBuilder{}.appendLeftPadded(payload, 1));
+}
+
+TEST_CASE("Aggregate secret key signing matches per-node signing", "[service node list]") {
+    ServiceNodeList snl(7);
+    const auto      signers = snl.randomSigners(5);
+
+    snl.signingMode             = ServiceNodeList::SigningMode::PerNode;
+    const std::string perNode   = snl.aggregateSignatures(MESSAGE_HEX, CHAIN_ID, CONTRACT_ADDRESS);
+    const std::string perNodeUR = snl.updateRewardsBalance("0x1234567890123456789012345678901234567890", 1000, CHAIN_ID, std::string(CONTRACT_ADDRESS), signers);
+
+    snl.signingMode = ServiceNodeList::SigningMode::AggregateSecretKey;
+    CHECK(snl.aggregateSignatures(MESSAGE_HEX, CHAIN_ID, CONTRACT_ADDRESS) == perNode);
+    CHECK(snl.updateRewardsBalance("0x1234567890123456789012345678901234567890", 1000, CHAIN_ID, std::string(CONTRACT_ADDRESS), signers) == perNodeUR);
+
+    snl.signingMode = ServiceNodeList::SigningMode::CrossCheck;
+    CHECK_NOTHROW(snl.aggregateSignatures(MESSAGE_HEX, CHAIN_ID, CONTRACT_ADDRESS));
+}
+
+TEST_CASE("Fixed-base tables multiply identically to mulCT", "[service node list]") {
+    ServiceNodeList       snl(1, 1); // NOTE: Initialises the curve
+    const PreparedMessage prepared = PreparedMessage::prepare(std::vector<uint8_t>{0xde, 0xad, 0xbe, 0xef}, CHAIN_ID, CONTRACT_ADDRESS);
+
+    // NOTE: 0, 1 and r - 1 set the first, last and every window respectively
+    std::vector<mcl::bn::Fr> scalars(3);
+    scalars[0] = 0;
+    scalars[1] = 1;
+    scalars[2] = -1;
+    for (size_t i = 0; i < 8; i++)
+        scalars.emplace_back().setByCSPRNG();
+
+    for (size_t windowBits = G2FixedBaseTable::MIN_WINDOW_BITS; windowBits <= G2FixedBaseTable::MAX_WINDOW_BITS; windowBits++) {
+        INFO("Window of " << windowBits << " bits");
+        const G2FixedBaseTable table{prepared.Hm, windowBits};
+        for (const mcl::bn::Fr& scalar : scalars) {
+            mcl::bn::G2 expected;
+            mcl::bn::G2::mulCT(expected, prepared.Hm, scalar);
+            CHECK(table.mul(scalar) == expected);
+        }
+    }
+
+    CHECK_THROWS_AS(G2FixedBaseTable(prepared.Hm, G2FixedBaseTable::MAX_WINDOW_BITS + 1), std::invalid_argument);
+    CHECK(G2FixedBaseTable::optimalWindowBits(1) < G2FixedBaseTable::optimalWindowBits(10'000));
+
+    PreparedMessage precomputed = prepared;
+    precomputed.precompute(snl.nodes.size());
+    CHECK(utils::SignatureToHex(snl.nodes[0].signPrepared(precomputed)) == utils::SignatureToHex(snl.nodes[0].signPrepared(prepared)));
+}
+
+TEST_CASE("Public keys derived from the generator table match bls", "[service node list]") {
+    ServiceNodeList snl(ServiceNodeList::GENERATOR_TABLE_MIN_NODES, 1);
+    REQUIRE(snl.generatorTable);
+    CHECK_FALSE(ServiceNodeList(1, 1).generatorTable);
+
+    // NOTE: The generator set by the service node list's constructor
+    mcl::bn::G1 generator;
+    bool        mapped = false;
+    mcl::bn::mapToG1(&mapped, generator, 1);
+    REQUIRE(mapped);
+
+    snl.addNode();
+    for (const auto& node : snl.nodes) {
+        mcl::bn::G1 expected;
+        mcl::bn::G1::mulCT(expected, generator, node.getSecretScalar());
+        CHECK(*reinterpret_cast<const mcl::bn::G1*>(&node.getPublicKey().getPtr()->v) == expected);
+    }
+
+    // NOTE: Nodes added without the table sum into the same aggregate key
+    snl.generatorTable.reset();
+    snl.addNode();
+    bls::PublicKey aggregate;
+    aggregate.clear();
+    for (const auto& node : snl.nodes)
+        aggregate.add(node.getPublicKey());
+    CHECK(snl.aggregatePubkeyHex() == utils::BLSPublicKeyToHex(aggregate));
+}
+
+TEST_CASE("Per-node signing with a precomputed message table matches the summed key", "[service node list]") {
+    ServiceNodeList snl(40, 2);
+    const auto      signers = snl.randomSigners(snl.precomputeMinSigners + 1);
+
+    snl.signingMode            = ServiceNodeList::SigningMode::AggregateSecretKey;
+    const std::string summed   = snl.aggregateSignatures(MESSAGE_HEX, CHAIN_ID, CONTRACT_ADDRESS);
+    const std::string summedUR = snl.updateRewardsBalance("0x1234567890123456789012345678901234567890", 1000, CHAIN_ID, std::string(CONTRACT_ADDRESS), signers);
+
+    snl.signingMode = ServiceNodeList::SigningMode::PerNode;
+    CHECK(snl.aggregateSignatures(MESSAGE_HEX, CHAIN_ID, CONTRACT_ADDRESS) == summed);
+    CHECK(snl.updateRewardsBalance("0x1234567890123456789012345678901234567890", 1000, CHAIN_ID, std::string(CONTRACT_ADDRESS), signers) == summedUR);
+
+    snl.precomputeMinSigners = SIZE_MAX;
+    CHECK(snl.aggregateSignatures(MESSAGE_HEX, CHAIN_ID, CONTRACT_ADDRESS) == summed);
+}
+
+TEST_CASE("Incremental aggregate public key matches a full re-aggregation", "[service node list]") {
+    ServiceNodeList snl(5, 1);
+    snl.deleteNode(2);
+    snl.addNode();
+    snl.deleteNode(5);
+    snl.deleteNode(1);
+
+    bls::PublicKey expected;
+    expected.clear();
+    for (const auto& node : snl.nodes)
+        expected.add(node.getPublicKey());
+    CHECK(snl.aggregatePubkeyHex() == utils::BLSPublicKeyToHex(expected));
+}
+
+TEST_CASE("Service node lookup and linked list survive swap-remove deletion", "[service node list]") {
+    ServiceNodeList snl(4, 1);
+    snl.deleteNode(2);
+    snl.addNode(); // 5
+    snl.deleteNode(1);
+
+    // NOTE: Walk the list, nodes were appended to the tail so IDs are ascending
+    std::vector<uint64_t> walked;
+    for (uint64_t id = snl.nextServiceNodeID(SERVICE_NODE_LIST_SENTINEL); id != SERVICE_NODE_LIST_SENTINEL; id = snl.nextServiceNodeID(id)) {
+        CHECK(snl.nextServiceNodeID(snl.prevServiceNodeID(id)) == id);
+        walked.push_back(id);
+    }
+    CHECK(walked == std::vector<uint64_t>{3, 4, 5});
+    CHECK(snl.prevServiceNodeID(SERVICE_NODE_LIST_SENTINEL) == 5);
+
+    for (uint64_t id : walked) {
+        int64_t index = snl.findNodeIndex(id);
+        REQUIRE(index >= 0);
+        CHECK(snl.nodes[static_cast<size_t>(index)].service_node_id == id);
+    }
+    CHECK(snl.findNodeIndex(1) == -1);
+    CHECK(snl.findNodeIndex(2) == -1);
+    CHECK(snl.getLatestNodePubkey() == snl.nodes[static_cast<size_t>(snl.findNodeIndex(5))].getPublicKeyHex());
+
+    // NOTE: Signing with a deleted or unknown node must not index past `nodes`
+    const std::string address = "0x1234567890123456789012345678901234567890";
+    CHECK_THROWS_AS(snl.updateRewardsBalance(address, 1000, CHAIN_ID, std::string(CONTRACT_ADDRESS), {3, 2}), std::invalid_argument);
+    CHECK_THROWS_AS(snl.exitNodeFromIndices(1, CHAIN_ID, std::string(CONTRACT_ADDRESS), {3, 4}), std::invalid_argument);
+    CHECK_THROWS_AS(snl.exitNodeFromIndices(3, CHAIN_ID, std::string(CONTRACT_ADDRESS), {3, 99}), std::invalid_argument);
+}
+
+TEST_CASE("Non-signers are found from a signer set in ascending order", "[service node list]") {
+    ServiceNodeList snl(200, 1);
+    snl.deleteNode(10); // NOTE: Shuffle the storage order via swap-remove
+    snl.deleteNode(3);
+
+    const std::vector<uint64_t> signers = {199, 1, 150, 64, 65, 2, 128};
+    const std::vector<uint64_t> nonSigners = snl.findNonSigners(signers);
+    CHECK(nonSigners.size() == snl.nodes.size() - signers.size());
+    CHECK(std::is_sorted(nonSigners.begin(), nonSigners.end()));
+    for (uint64_t id : nonSigners)
+        CHECK(std::find(signers.begin(), signers.end(), id) == signers.end());
+    CHECK(std::find(nonSigners.begin(), nonSigners.end(), 3) == nonSigners.end());
+    CHECK(snl.findNonSigners(SignerSet(signers)) == nonSigners);
+}
+
+TEST_CASE("Aggregate signatures verify offline like the contract", "[service node list][verify]") {
+    ServiceNodeList snl(6, 1);
+    const std::vector<uint8_t> message     = ethyl::utils::fromHexString<uint8_t>(MESSAGE_HEX);
+    const auto                 hashToG2Tag = utils::BuildTag("BLS_SIG_HASH_TO_FIELD_TAG", CHAIN_ID, CONTRACT_ADDRESS);
+
+    // NOTE: Nodes at index 1 and 4 do not sign
+    const std::vector<int64_t>        signerIndices    = {0, 2, 3, 5};
+    const std::vector<bls::PublicKey> nonSignerPubkeys = {snl.nodes[1].getPublicKey(), snl.nodes[4].getPublicKey()};
+    const std::string                 sigHex           = snl.aggregateSignaturesFromIndices(MESSAGE_HEX, signerIndices, CHAIN_ID, CONTRACT_ADDRESS);
+    const bls::Signature              sig              = utils::HexToSignature(sigHex);
+    CHECK(utils::SignatureToHex(sig) == sigHex);
+
+    CHECK(utils::VerifyAggregateSignature(message, hashToG2Tag, sig, snl.aggregatePubkey, nonSignerPubkeys));
+    CHECK_FALSE(utils::VerifyAggregateSignature(message, hashToG2Tag, sig, snl.aggregatePubkey, {}));
+
+    SECTION("Batch verification") {
+        const mcl::bn::G2 Hm = utils::HashToG2(message, hashToG2Tag);
+        std::vector<utils::SignatureCheck> checks;
+        for (const auto& node : snl.nodes)
+            checks.push_back({Hm, node.signPrepared(PreparedMessage{Hm, nullptr}), node.getPublicKey()});
+        checks.push_back({Hm, sig, utils::SignersPubkey(snl.aggregatePubkey, nonSignerPubkeys)});
+        CHECK(utils::VerifySignatureBatch(checks));
+
+        // NOTE: Swap two signatures, every check now fails individually
+        std::swap(checks[0].signature, checks[1].signature);
+        CHECK_FALSE(utils::VerifySignatureBatch(checks));
+    }
+}
@@ -0,0 +1,175 @@
+#include <algorithm>
+#include <map>
+#include <set>
+#include <sstream>
+
+#include "ethyl/signer.hpp"
+#include "ethyl/utils.hpp"
+#include "service_node_rewards/transaction_pipeline.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_all.hpp>
+
+static const std::string CONTRACT_ADDRESS = "0x5FC8d32690cc91D4c39d9d3abcBD16989F875707";
+
+// NOTE: Hardhat's first debug account, the transactions are only signed and
+// handed to `FakeNode`
+static const std::string SECRET_KEY = "ac0974bec39a17e36ba4a6b4d238ff944bacb478cbed5efcae784d7bf4f2ff80";
+
+static std::string toQuantity(uint64_t value) {
+    std::stringstream stream;
+    stream << "0x" << std::hex << value;
+    return stream.str();
+}
+
+/// Answers the pipeline's JSON-RPC batches with canned responses in place of
+/// a node. Raw transactions are numbered in the order they are received and
+/// are mined by the next receipt poll unless listed in `unmined`.
+struct FakeNode {
+    uint64_t         pendingNonce = 7;
+    uint64_t         baseFee      = 1'000;
+    std::set<size_t> rejected; // NOTE: Raw transactions the node refuses to accept
+    std::set<size_t> unmined;  // NOTE: Raw transactions that never get a receipt
+
+    size_t                        sent       = 0;
+    size_t                        feeReads   = 0;
+    size_t                        nonceReads = 0;
+    std::map<std::string, size_t> hashes;
+
+    std::string answer(const std::string& body) {
+        nlohmann::json responses = nlohmann::json::array();
+        for (const nlohmann::json& request : nlohmann::json::parse(body)) {
+            nlohmann::json    response = {{"jsonrpc", "2.0"}, {"id", request.at("id")}};
+            const std::string method   = request.at("method").get<std::string>();
+            if (method == "eth_chainId") {
+                response["result"] = toQuantity(31337);
+            } else if (method == "eth_maxPriorityFeePerGas") {
+                response["result"] = toQuantity(100);
+            } else if (method == "eth_feeHistory") {
+                feeReads++;
+                response["result"] = {{"oldestBlock", "0x1"}, {"baseFeePerGas", {toQuantity(1), toQuantity(baseFee)}}, {"gasUsedRatio", {0.5}}};
+            } else if (method == "eth_getTransactionCount") {
+                nonceReads++;
+                response["result"] = toQuantity(pendingNonce);
+            } else if (method == "eth_sendRawTransaction") {
+                size_t index = sent++;
+                if (rejected.contains(index)) {
+                    response["error"] = {{"code", -32000}, {"message", "replacement transaction underpriced"}};
+                } else {
+                    std::string hash = "0x" + std::string(62, '0') + toQuantity(0x10 + index).substr(2);
+                    hashes[hash]     = index;
+                    pendingNonce++;
+                    response["result"] = hash;
+                }
+            } else if (method == "eth_getTransactionReceipt") {
+                const std::string hash = request.at("params").at(0).get<std::string>();
+                if (unmined.contains(hashes.at(hash)))
+                    response["result"] = nullptr;
+                else
+                    response["result"] = {{"transactionHash", hash}, {"status", "0x1"}};
+            } else {
+                FAIL("Unexpected JSON-RPC method " << method);
+            }
+            responses.push_back(std::move(response));
+        }
+
+        // NOTE: Nodes may answer a batch out of order
+        std::reverse(responses.begin(), responses.end());
+        return responses.dump();
+    }
+};
+
+static TransactionPipeline makePipeline(ethyl::Signer& signer, FakeNode& node, size_t maxInFlight) {
+    TransactionPipeline result{signer, ethyl::utils::fromHexString(SECRET_KEY), "http://127.0.0.1:8545", maxInFlight};
+    result.transport = [&node](const std::string& body) { return node.answer(body); };
+    return result;
+}
+
+static ethyl::Transaction makeTransaction() {
+    return ethyl::Transaction{CONTRACT_ADDRESS, 0, 30'000};
+}
+
+TEST_CASE("Transaction pipeline numbers nonces locally and re-reads fees every wait", "[transaction pipeline]") {
+    ethyl::Signer       signer;
+    FakeNode            node;
+    TransactionPipeline pipeline = makePipeline(signer, node, 2);
+
+    for (size_t index = 0; index < 3; index++)
+        CHECK(pipeline.submit(makeTransaction()) == index);
+    std::vector<TransactionPipeline::Result> results = pipeline.wait();
+    REQUIRE(results.size() == 3);
+    for (size_t index = 0; index < results.size(); index++) {
+        INFO("Transaction " << index);
+        CHECK(results[index].success);
+        CHECK(results[index].error.empty());
+        CHECK(results[index].nonce == 7 + index);
+    }
+    CHECK(pipeline.size() == 0);
+    CHECK(node.feeReads == 1);
+    CHECK(node.nonceReads == 1);
+
+    // NOTE: The next batch continues from the local nonce even though the
+    // node now reports a different one, but prices at the new base fee
+    node.pendingNonce = 100;
+    node.baseFee      = 5'000;
+    pipeline.submit(makeTransaction());
+    results = pipeline.wait();
+    REQUIRE(results.size() == 1);
+    CHECK(results[0].success);
+    CHECK(results[0].nonce == 10);
+    CHECK(node.feeReads == 2);
+    CHECK(node.nonceReads == 1);
+}
+
+TEST_CASE("Transaction pipeline resyncs its nonce after a rejected transaction", "[transaction pipeline]") {
+    ethyl::Signer       signer;
+    FakeNode            node;
+    TransactionPipeline pipeline = makePipeline(signer, node, 2);
+    node.rejected                = {1};
+
+    for (size_t index = 0; index < 4; index++)
+        pipeline.submit(makeTransaction());
+    std::vector<TransactionPipeline::Result> results = pipeline.wait();
+    REQUIRE(results.size() == 4);
+
+    CHECK(results[0].success);
+    CHECK(results[0].nonce == 7);
+
+    // NOTE: The rejected transaction's nonce was never used, the node's
+    // pending nonce is re-read and the next transactions reuse it
+    CHECK_FALSE(results[1].success);
+    CHECK(results[1].hash.empty());
+    CHECK(results[1].receipt.is_null());
+    CHECK(results[1].error.find("replacement transaction underpriced") != std::string::npos);
+    CHECK(results[1].nonce == 8);
+
+    CHECK(results[2].success);
+    CHECK(results[2].nonce == 8);
+    CHECK(results[3].success);
+    CHECK(results[3].nonce == 9);
+    CHECK(node.nonceReads == 2);
+}
+
+TEST_CASE("Transaction pipeline reports transactions that time out", "[transaction pipeline]") {
+    ethyl::Signer       signer;
+    FakeNode            node;
+    TransactionPipeline pipeline = makePipeline(signer, node, 1);
+    node.unmined                 = {0};
+
+    pipeline.submit(makeTransaction());
+    pipeline.submit(makeTransaction());
+    std::vector<TransactionPipeline::Result> results = pipeline.wait(std::chrono::milliseconds(0));
+    REQUIRE(results.size() == 2);
+
+    // NOTE: The first transaction was accepted but never mined, the second
+    // could not be sent whilst the first occupied the only slot
+    CHECK_FALSE(results[0].success);
+    CHECK_FALSE(results[0].hash.empty());
+    CHECK(results[0].receipt.is_null());
+    CHECK(results[0].error == "Transaction " + results[0].hash + " was not mined within 0ms");
+
+    CHECK_FALSE(results[1].success);
+    CHECK(results[1].hash.empty());
+    CHECK(results[1].error == "Transaction was not sent before the timeout");
+    CHECK(node.sent == 1);
+}
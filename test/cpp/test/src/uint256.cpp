@@ -0,0 +1,88 @@
+#include <limits>
+#include <sstream>
+#include <string>
+
+#include "service_node_rewards/abi.hpp"
+#include "service_node_rewards/erc20_contract.hpp"
+#include "service_node_rewards/service_node_rewards_contract.hpp"
+#include "service_node_rewards/uint256.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_all.hpp>
+
+// NOTE: 2^255 + 12345678901234567890123456789
+static const std::string LARGE_HEX     = "800000000000000000000000000000000000000027e41b3246bec9b16e398115";
+static const std::string LARGE_DECIMAL = "57896044618658097711785492504343953926634992332832627698630026571846688276757";
+static const std::string MAX_DECIMAL   = "115792089237316195423570985008687907853269984665640564039457584007913129639935";
+
+TEST_CASE("Uint256 converts to and from hex, bytes and decimal", "[uint256]") {
+    Uint256 value = Uint256::fromHex("0x" + LARGE_HEX);
+    CHECK(value.limbs[3] == 0x8000000000000000);
+    CHECK(value.limbs[1] == 0x27e41b32);
+    CHECK(value.limbs[0] == 0x46bec9b16e398115);
+    CHECK(value.toHex() == LARGE_HEX);
+    CHECK(value.toString() == LARGE_DECIMAL);
+    CHECK(Uint256::fromBigEndian(value.toBigEndian()) == value);
+
+    // NOTE: JSON-RPC quantities are not padded and may have leading zeros
+    CHECK(Uint256::fromHex("0x1") == 1);
+    CHECK(Uint256::fromHex("0x0") == 0);
+    CHECK(Uint256::fromHex("000000000000000000000000000000000000000000000000000000000000000000ff") == 255);
+    CHECK(Uint256::fromHex("0x68155a43676e00000").toString() == "120000000000000000000");
+    CHECK(Uint256(0).toString() == "0");
+    CHECK(Uint256(1'000'000'000).toString() == "1000000000");
+
+    Uint256 max = Uint256(0) - 1;
+    CHECK(max.toHex() == std::string(64, 'f'));
+    CHECK(max.toString() == MAX_DECIMAL);
+
+    std::stringstream stream;
+    stream << Uint256(120'000'000'000);
+    CHECK(stream.str() == "120000000000");
+
+    CHECK(Uint256(std::numeric_limits<uint64_t>::max()).toUint64() == std::numeric_limits<uint64_t>::max());
+    CHECK_THROWS_AS(value.toUint64(), std::overflow_error);
+    CHECK_THROWS_AS(Uint256::fromHex("1" + std::string(64, '0')), std::overflow_error);
+    CHECK_THROWS_AS(Uint256::fromHex("0xzz"), std::invalid_argument);
+}
+
+TEST_CASE("Uint256 arithmetic wraps modulo 2^256", "[uint256]") {
+    Uint256 a = Uint256::fromHex(LARGE_HEX);
+    Uint256 b = Uint256::fromHex("fedcba9876543210fedcba9876543210");
+
+    // NOTE: Expected values generated with python's arbitrary precision integers
+    CHECK((a + b).toHex() == "80000000000000000000000000000000fedcba989e384d43459b8449e48db325");
+    CHECK((b - a).toHex() == "80000000000000000000000000000000fedcba984e7016deb81df0e7081ab0fb");
+    CHECK((a * b).toHex() == "0000000027b6b816bf0908834c0dd78b635addf74c094ac4a451d57427b22b50");
+    CHECK(a + b - b == a);
+
+    // NOTE: Carries propagate across every limb
+    Uint256 max = Uint256(0) - 1;
+    CHECK(max + 1 == 0);
+    CHECK(max * max == 1);
+    CHECK(Uint256(std::numeric_limits<uint64_t>::max()) + 1 == Uint256::fromHex("10000000000000000"));
+
+    CHECK(b < a);
+    CHECK(Uint256(1) < Uint256::fromHex("10000000000000000"));
+    CHECK(Uint256::fromHex("10000000000000000") > std::numeric_limits<uint64_t>::max());
+}
+
+TEST_CASE("Amounts beyond 64 bits are encoded and decoded", "[uint256]") {
+    const Uint256 amount = Uint256::fromHex(LARGE_HEX);
+
+    ERC20Contract erc20;
+    erc20.contractAddress = "0x5FbDB2315678afecb367f032d93F642f64180aa3";
+    CHECK(erc20.transfer("0x70997970c51812dc3a010c7d01b50e0d17dc79c8", amount).data == std::string(ERC20Contract::TRANSFER.view()) +
+            "00000000000000000000000070997970c51812dc3a010c7d01b50e0d17dc79c8" + LARGE_HEX);
+    CHECK(ERC20Contract::decodeBalanceOf("0x" + LARGE_HEX) == amount);
+
+    Recipient recipient = ServiceNodeRewardsContract::decodeRecipient(LARGE_HEX + "0000000000000000000000000000000000000000000000068155a43676e00000");
+    CHECK(recipient.rewards == amount);
+    CHECK(recipient.claimed.toString() == "120000000000000000000");
+
+    ServiceNodeRewardsContract rewards;
+    rewards.contractAddress = "0x5FC8d32690cc91D4c39d9d3abcBD16989F875707";
+    CHECK(rewards.claimRewards(amount).data == std::string(ServiceNodeRewardsContract::CLAIM_REWARDS_AMOUNT.view()) + LARGE_HEX);
+    CHECK(AbiDecoder{LARGE_HEX}.uint256(0) == amount);
+    CHECK_THROWS_AS(AbiDecoder{LARGE_HEX}.uint64(0), std::overflow_error);
+}